@@ -0,0 +1,117 @@
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "api_client.h"
+#include "api_bench.h"
+
+#define WORD_SIZE 6
+
+typedef struct {
+    int64_t *latency_us;
+    int count;
+} latency_samples_t;
+
+static const char *TAG = "api_bench";
+
+static int compare_latency(const void *a, const void *b) {
+    int64_t lhs = *(const int64_t *)a;
+    int64_t rhs = *(const int64_t *)b;
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+/**
+ * @brief Checks that a word or result pattern has the expected 5 characters.
+ *
+ * @param value The null terminated value returned by the client.
+ * @param allowed Characters a valid value may contain.
+ * @return true if the value is well formed.
+ */
+static bool is_well_formed(const char *value, const char *allowed) {
+    if (strlen(value) != WORD_SIZE - 1) {
+        return false;
+    }
+    for (int i = 0; i < WORD_SIZE - 1; i++) {
+        if (strchr(allowed, value[i]) == NULL) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Sorts the samples and logs their percentiles.
+ *
+ * @param name Label for the log line.
+ * @param samples The samples, sorted in place.
+ */
+static void log_percentiles(const char *name, latency_samples_t *samples) {
+    if (samples->count == 0) {
+        ESP_LOGI(TAG, "%-8s n=0", name);
+        return;
+    }
+
+    qsort(samples->latency_us, samples->count, sizeof(int64_t), compare_latency);
+
+    // Nearest-rank percentiles
+    int last = samples->count - 1;
+    ESP_LOGI(TAG, "%-8s n=%-4d p50 %5lld ms  p90 %5lld ms  p99 %5lld ms  max %5lld ms", name, samples->count,
+             samples->latency_us[last * 50 / 100] / 1000,
+             samples->latency_us[last * 90 / 100] / 1000,
+             samples->latency_us[last * 99 / 100] / 1000,
+             samples->latency_us[last] / 1000);
+}
+
+esp_err_t api_bench_run(int request_count) {
+    // One buffer, successes fill it from the front and failures from the back
+    int64_t *latency_us = malloc(request_count * sizeof(int64_t));
+    if (latency_us == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    latency_samples_t ok = { .latency_us = latency_us, .count = 0 };
+    latency_samples_t failed = { .latency_us = latency_us, .count = 0 };
+    int malformed = 0;
+    char word[WORD_SIZE] = "crane";
+
+    ESP_LOGI(TAG, "Sending %d requests", request_count);
+
+    for (int i = 0; i < request_count; i++) {
+        char value[WORD_SIZE] = {0};
+        bool is_word = (i % 2) == 0;
+        esp_err_t err;
+
+        int64_t start_us = esp_timer_get_time();
+        if (is_word) {
+            err = api_get_word(value, sizeof(value));
+        } else {
+            memcpy(value, word, sizeof(value));
+            err = api_check_word(value, sizeof(value));
+        }
+        int64_t elapsed_us = esp_timer_get_time() - start_us;
+
+        if (err == ESP_OK) {
+            ok.latency_us[ok.count++] = elapsed_us;
+
+            // A success must never hand back a half parsed value
+            if (!is_well_formed(value, is_word ? "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ" : "+x-")) {
+                ESP_LOGE(TAG, "Request %d succeeded with malformed value \"%s\"", i, value);
+                malformed++;
+            } else if (is_word) {
+                memcpy(word, value, sizeof(word));
+            }
+        } else {
+            failed.count++;
+            latency_us[request_count - failed.count] = elapsed_us;
+        }
+    }
+    failed.latency_us = latency_us + request_count - failed.count;
+
+    ESP_LOGI(TAG, "%d ok, %d failed, %d malformed", ok.count, failed.count, malformed);
+    log_percentiles("ok", &ok);
+    log_percentiles("failed", &failed);
+
+    free(latency_us);
+    return ESP_OK;
+}
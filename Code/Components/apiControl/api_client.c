@@ -1,9 +1,17 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <strings.h>
+#include <time.h>
+#include <sys/time.h>
 #include "esp_log.h"
 #include "esp_http_client.h"
+#include "esp_timer.h"
+#include "json_extract.h"
+#ifdef CONFIG_API_JSON_PARSER_CJSON
 #include "cJSON.h"
+#include "cjson_arena.h"
+#endif
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "api_client.h" 
@@ -40,13 +48,17 @@ const char *root_cert =
 
 #define WORD_SIZE 6
 #define BUFFER_SIZE 1024
-#define GET_WORD_URL "https://wordle-game-api1.p.rapidapi.com/word"
-#define CHECK_WORD_URL "https://wordle-game-api1.p.rapidapi.com/guess"
+#define GET_WORD_URL CONFIG_API_GET_WORD_URL        // Set in menuconfig, can point at the mock server
+#define CHECK_WORD_URL CONFIG_API_CHECK_WORD_URL
+#define MIN_VALID_YEAR 2024 // Anything before this means the clock was never set
+#define UTC_OFFSET_HOURS CONFIG_API_UTC_OFFSET_HOURS  // The word rolls over at midnight in this timezone
+#define TIMEZONE_SIZE 12    // "UTC + 14" plus the null terminator
 
 typedef struct {
     char *buffer;
     int buffer_size;
     int data_length;
+    bool overflow;
 } response_data_t;
 
 typedef enum {
@@ -54,58 +66,249 @@ typedef enum {
     HTTP_ERROR_OPEN_CONNECTION,
     HTTP_ERROR_WRITE_FAILED,
     HTTP_ERROR_FETCH_HEADERS_FAILED,
-    HTTP_ERROR_READ_RESPONSE_FAILED
+    HTTP_ERROR_READ_RESPONSE_FAILED,
+    HTTP_ERROR_RESPONSE_TOO_LARGE,
+    HTTP_ERROR_STATUS               // Server answered with a non 2xx status (e.g. 429 rate limited)
 } http_error_t;
 
+// Used to keep per-endpoint parser statistics
+typedef enum {
+    API_ENDPOINT_WORD = 0,
+    API_ENDPOINT_GUESS
+} api_endpoint_t;
+
+typedef struct {
+    int64_t request_start_us;
+    int64_t connected_us;
+    bool is_connected;
+} connection_stats_t;
+
 static const char *TAG = "api_client";
 static esp_http_client_handle_t client;
 static esp_http_client_config_t config;
-static response_data_t response;
-static void extract_word(const char *json_string, size_t json_size, char *word_buffer, size_t buffer_size);
-static void extract_result(const char *json_string, size_t json_size, char *word_buffer, size_t buffer_size);
+static char response_buffer[BUFFER_SIZE + 1];    // Shared by every request, +1 for the null terminator
+static response_data_t response = {
+    .buffer = response_buffer,
+    .buffer_size = BUFFER_SIZE
+};
+static connection_stats_t connection;
+static esp_err_t get_word(int utc_offset_hours, char *word, int word_size);
+static bool extract_word(const char *json_string, size_t json_size, char *word_buffer, size_t buffer_size);
+static bool extract_result(const char *json_string, size_t json_size, char *word_buffer, size_t buffer_size);
+static bool extract_string_field(const char *json_string, size_t json_size, api_endpoint_t endpoint, const char *field, char *buffer, size_t buffer_size);
+
+/**
+ * @brief Formats a UTC offset the way the API expects it, e.g. "UTC + 8" or "UTC - 5".
+ *
+ * @param utc_offset_hours Local time minus UTC, in hours.
+ * @param tz_name Buffer for the timezone, at least TIMEZONE_SIZE bytes.
+ */
+static void format_timezone(int utc_offset_hours, char *tz_name) {
+    snprintf(tz_name, TIMEZONE_SIZE, "UTC %c %d", utc_offset_hours < 0 ? '-' : '+', abs(utc_offset_hours));
+}
+
+/**
+ * @brief Sets the system clock from an HTTP Date header if the clock was never set.
+ *
+ * Gives the device a usable date (for the daily word cache) without a time server.
+ *
+ * @param http_date Header value in RFC 1123 format, e.g. "Sun, 06 Nov 1994 08:49:37 GMT".
+ */
+static void set_clock_from_http_date(const char *http_date) {
+    static const char months[] = "JanFebMarAprMayJunJulAugSepOctNovDec";
+    char month_name[4] = {0};
+    int day, year, hour, minute, second;
+    time_t now = time(NULL);
+    struct tm current;
+
+    gmtime_r(&now, &current);
+    if (current.tm_year + 1900 >= MIN_VALID_YEAR) {
+        return;
+    }
+
+    if (sscanf(http_date, "%*3s, %d %3s %d %d:%d:%d", &day, month_name, &year, &hour, &minute, &second) != 6) {
+        return;
+    }
+    const char *month_pos = strstr(months, month_name);
+    if (month_pos == NULL || (month_pos - months) % 3 != 0) {
+        return;
+    }
+    int month = (month_pos - months) / 3 + 1;
+
+    // Days since 1970-01-01 for a proleptic Gregorian date
+    int y = year - (month <= 2);
+    int era = (y >= 0 ? y : y - 399) / 400;
+    int yoe = y - era * 400;
+    int doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    int64_t days = (int64_t)era * 146097 + doe - 719468;
+
+    struct timeval tv = {
+        .tv_sec = days * 86400 + hour * 3600 + minute * 60 + second,
+        .tv_usec = 0
+    };
+    settimeofday(&tv, NULL);
+    ESP_LOGI(TAG, "Clock set from server date: %s", http_date);
+}
 
 /**
- * @brief Makes an HTTP POST request to the specified URL with the given post data.
+ * @brief HTTP client event handler, streams the response body into the shared buffer,
+ * tracks connection reuse and handshake time and picks up the server date.
+ *
+ * @param evt The HTTP client event.
+ * @return esp_err_t Always ESP_OK.
+ */
+static esp_err_t http_event_handler(esp_http_client_event_t *evt) {
+    switch (evt->event_id) {
+        case HTTP_EVENT_ON_CONNECTED:
+            // Fires once the TCP + TLS handshake completes, not for reused connections
+            connection.connected_us = esp_timer_get_time();
+            connection.is_connected = true;
+            break;
+
+        case HTTP_EVENT_DISCONNECTED:
+            connection.is_connected = false;
+            break;
+
+        case HTTP_EVENT_ON_DATA:
+            // Called per received piece, chunked bodies arrive here already decoded
+            if (response.data_length + evt->data_len > response.buffer_size) {
+                response.overflow = true;   // Keep draining so the connection stays usable
+            } else {
+                memcpy(response.buffer + response.data_length, evt->data, evt->data_len);
+                response.data_length += evt->data_len;
+            }
+            break;
+
+        case HTTP_EVENT_ON_HEADER:
+            if (strcasecmp(evt->header_key, "Date") == 0) {
+                set_clock_from_http_date(evt->header_value);
+            }
+            break;
+
+        default:
+            break;
+    }
+    return ESP_OK;
+}
+
+/**
+ * @brief Sends a single HTTP POST request on the client's current connection.
+ *
+ * The body is streamed into the shared response buffer by the event handler.
  *
  * @param url The URL to send the POST request to.
  * @param post_data The data to include in the POST request body.
- * @param output_buffer Buffer to store the response.
- * @param buffer_size Size of the output_buffer.
  * @return http_error_t Returns an error code indicating the success or failure of the request.
  */
-static http_error_t make_post_request(const char *url, const char *post_data, char *output_buffer, int buffer_size) {
-    esp_err_t err = ESP_OK;
+static http_error_t send_post_request(const char *url, const char *post_data) {
     http_error_t error_code = HTTP_SUCCESS;
 
+    response.data_length = 0;
+    response.overflow = false;
+
     esp_http_client_set_url(client, url);
     esp_http_client_set_method(client, HTTP_METHOD_POST);
     esp_http_client_set_header(client, "Content-Type", "application/json");
-    err = esp_http_client_open(client, strlen(post_data));
-
-    if (err != ESP_OK) {
-        error_code = HTTP_ERROR_OPEN_CONNECTION;
-    } else {
-        int wlen = esp_http_client_write(client, post_data, strlen(post_data));
-        if (wlen < 0) {
-            error_code = HTTP_ERROR_WRITE_FAILED;
-        } else {
-            int content_length = esp_http_client_fetch_headers(client);
-            if (content_length < 0) {
-                error_code = HTTP_ERROR_FETCH_HEADERS_FAILED;
+    esp_http_client_set_post_field(client, post_data, strlen(post_data));
+
+    switch (esp_http_client_perform(client)) {
+        case ESP_OK: {
+            int status = esp_http_client_get_status_code(client);
+            if (status < 200 || status >= 300) {
+                ESP_LOGE(TAG, "Server returned HTTP %d", status);
+                error_code = HTTP_ERROR_STATUS;
             } else {
-                int data_read = esp_http_client_read_response(client, output_buffer, buffer_size);
-                if (data_read >= 0) {
-                    error_code = HTTP_SUCCESS;
-                } else {
-                    error_code = HTTP_ERROR_READ_RESPONSE_FAILED;
-                }
+                error_code = response.overflow ? HTTP_ERROR_RESPONSE_TOO_LARGE : HTTP_SUCCESS;
             }
+            break;
         }
+        case ESP_ERR_HTTP_CONNECT:
+            error_code = HTTP_ERROR_OPEN_CONNECTION;
+            break;
+        case ESP_ERR_HTTP_WRITE_DATA:
+            error_code = HTTP_ERROR_WRITE_FAILED;
+            break;
+        case ESP_ERR_HTTP_FETCH_HEADER:
+            error_code = HTTP_ERROR_FETCH_HEADERS_FAILED;
+            break;
+        default:
+            error_code = HTTP_ERROR_READ_RESPONSE_FAILED;
+            break;
+    }
+
+    response.buffer[response.overflow ? 0 : response.data_length] = '\0';
+
+    if (error_code != HTTP_SUCCESS && error_code != HTTP_ERROR_RESPONSE_TOO_LARGE && error_code != HTTP_ERROR_STATUS) {
+        // Drop the connection so the next request starts a fresh one
+        esp_http_client_close(client);
+    }
+    return error_code;
+}
+
+/**
+ * @brief Makes an HTTP POST request, reusing the kept-alive connection when possible.
+ *
+ * If the server dropped an idle kept-alive connection the request is retried once
+ * on a new connection. Handshake and total latency are logged for every request.
+ *
+ * @param url The URL to send the POST request to.
+ * @param post_data The data to include in the POST request body.
+ * @return http_error_t Returns an error code indicating the success or failure of the request.
+ */
+static http_error_t make_post_request(const char *url, const char *post_data) {
+    bool was_connected = connection.is_connected;
+
+    connection.request_start_us = esp_timer_get_time();
+    connection.connected_us = 0;
+
+    http_error_t error_code = send_post_request(url, post_data);
+    // Only transport failures are retried, a status error would just repeat
+    if (error_code != HTTP_SUCCESS && error_code != HTTP_ERROR_RESPONSE_TOO_LARGE &&
+        error_code != HTTP_ERROR_STATUS && was_connected) {
+        ESP_LOGW(TAG, "Kept-alive connection failed, retrying on a new connection");
+        connection.request_start_us = esp_timer_get_time();
+        connection.connected_us = 0;
+        error_code = send_post_request(url, post_data);
     }
+
+    int64_t total_ms = (esp_timer_get_time() - connection.request_start_us) / 1000;
+    if (connection.connected_us != 0) {
+        ESP_LOGI(TAG, "POST %s: handshake %lld ms, total %lld ms", url,
+                 (connection.connected_us - connection.request_start_us) / 1000, total_ms);
+    } else {
+        ESP_LOGI(TAG, "POST %s: connection reused, total %lld ms", url, total_ms);
+    }
+
     return error_code;
 }
 
 esp_err_t api_get_word(char* word, int word_size) {
+    return get_word(UTC_OFFSET_HOURS, word, word_size);
+}
+
+esp_err_t api_get_next_word(char* word, int word_size) {
+    // An hour further east it is already tomorrow, but only in the last hour before midnight.
+    // Outside of it (clock not set, or the request was queued past midnight) the word would be wrong
+    time_t local_now = time(NULL) + UTC_OFFSET_HOURS * 3600;
+    long to_midnight = 86400 - (long)(local_now % 86400);
+    if (to_midnight > API_NEXT_WORD_WINDOW_S) {
+        ESP_LOGE(TAG, "Tomorrow's word asked for %ld s before midnight, only known in the last %d s",
+                 to_midnight, API_NEXT_WORD_WINDOW_S);
+        return ESP_ERR_INVALID_STATE;
+    }
+    return get_word(UTC_OFFSET_HOURS + 1, word, word_size);
+}
+
+/**
+ * @brief Requests the word of the day in the given timezone.
+ *
+ * @param utc_offset_hours Timezone the day is taken in.
+ * @param word Buffer for the word.
+ * @param word_size Size of the buffer, at least WORD_SIZE.
+ * @return esp_err_t ESP_OK if a word was extracted, ESP_FAIL if the request failed.
+ */
+static esp_err_t get_word(int utc_offset_hours, char *word, int word_size) {
     if (word == NULL)
     {
         ESP_LOGE(TAG, "Word Pointer is Null");
@@ -119,20 +322,25 @@ esp_err_t api_get_word(char* word, int word_size) {
 
     ESP_LOGI(TAG, "Sending POST request to URL: %s", GET_WORD_URL);
 
-    const char *post_data = "{\"timezone\":\"UTC + 8\"}";
-    char output_buffer[BUFFER_SIZE] = {0};   // Buffer to store response of HTTP request
-    http_error_t error_code = make_post_request(GET_WORD_URL, post_data, output_buffer, BUFFER_SIZE);
+    char tz_name[TIMEZONE_SIZE];
+    char post_data[32];
+    format_timezone(utc_offset_hours, tz_name);
+    snprintf(post_data, sizeof(post_data), "{\"timezone\":\"%s\"}", tz_name);
+    http_error_t error_code = make_post_request(GET_WORD_URL, post_data);
+
+    esp_err_t ret = ESP_FAIL;
 
     switch (error_code) {
         case HTTP_SUCCESS:
             ESP_LOGI(TAG, "HTTP POST Status = %d, content_length = %lld",
                 esp_http_client_get_status_code(client),
                 esp_http_client_get_content_length(client));
-            ESP_LOG_BUFFER_HEXDUMP(TAG, output_buffer, strlen(output_buffer), ESP_LOG_DEBUG); //Debug line for hexdump and status codes
+            ESP_LOG_BUFFER_HEXDUMP(TAG, response.buffer, response.data_length, ESP_LOG_DEBUG); //Debug line for hexdump and status codes
             // Process the response to extract the word
-            // Replace this placeholder with actual parsing logic
-            extract_word(output_buffer, strlen(output_buffer), word, word_size);
-            printf("Extracted word: %s\n", word);
+            if (extract_word(response.buffer, response.data_length, word, word_size)) {
+                printf("Extracted word: %s\n", word);
+                ret = ESP_OK;
+            }
             break;
 
         case HTTP_ERROR_OPEN_CONNECTION:
@@ -155,6 +363,15 @@ esp_err_t api_get_word(char* word, int word_size) {
             word = NULL;
             break;
 
+        case HTTP_ERROR_RESPONSE_TOO_LARGE:
+            ESP_LOGE(TAG, "Response larger than %d bytes", BUFFER_SIZE);
+            word = NULL;
+            break;
+
+        case HTTP_ERROR_STATUS:
+            word = NULL;
+            break;
+
         default:
             ESP_LOGE(TAG, "An unknown error occurred");
             word = NULL;
@@ -162,11 +379,11 @@ esp_err_t api_get_word(char* word, int word_size) {
     }
 
     //esp_http_client_cleanup(client);
-    return ESP_OK;
+    return ret;
 }
 
     esp_err_t api_check_word(char* guess, int guess_size) {
-    char word_guess[5] = {0};
+    char word_guess[WORD_SIZE] = {0};
     
     if (guess == NULL)
     {
@@ -182,23 +399,27 @@ esp_err_t api_get_word(char* word, int word_size) {
     ESP_LOGI(TAG, "Sending POST request to URL: %s", CHECK_WORD_URL);
     ESP_LOG_BUFFER_HEXDUMP(TAG, word_guess, 6, ESP_LOG_DEBUG);
     
+    char tz_name[TIMEZONE_SIZE];
+    format_timezone(UTC_OFFSET_HOURS, tz_name);
+
     char post_data[50] = {0};
-    snprintf(post_data, 50, "{\"word\":\"%s\",\"timezone\":\"UTC + 8\"}", word_guess);
+    snprintf(post_data, 50, "{\"word\":\"%s\",\"timezone\":\"%s\"}", word_guess, tz_name);
     ESP_LOG_BUFFER_HEXDUMP(TAG, post_data, 50, ESP_LOG_DEBUG);
-    char output_buffer[BUFFER_SIZE] = {0};   // Buffer to store response of HTTP request
-    http_error_t error_code = make_post_request(CHECK_WORD_URL, post_data, output_buffer, BUFFER_SIZE);
+    http_error_t error_code = make_post_request(CHECK_WORD_URL, post_data);
     ESP_LOGI(TAG, "Entering api_check_word Switch Statement");
 
+    esp_err_t ret = ESP_FAIL;
+
     switch (error_code) {
         case HTTP_SUCCESS:
             ESP_LOGI(TAG, "HTTP POST Status = %d, content_length = %lld",
                 esp_http_client_get_status_code(client),
                 esp_http_client_get_content_length(client));
-            ESP_LOG_BUFFER_HEXDUMP(TAG, output_buffer, strlen(output_buffer), ESP_LOG_DEBUG);
+            ESP_LOG_BUFFER_HEXDUMP(TAG, response.buffer, response.data_length, ESP_LOG_DEBUG);
             // Process the response to extract the result
-            // Replace this placeholder with actual parsing logic
-            extract_result(output_buffer, strlen(output_buffer), guess, guess_size);
-
+            if (extract_result(response.buffer, response.data_length, guess, guess_size)) {
+                ret = ESP_OK;
+            }
             break;
 
         case HTTP_ERROR_OPEN_CONNECTION:
@@ -217,35 +438,47 @@ esp_err_t api_get_word(char* word, int word_size) {
             ESP_LOGE(TAG, "Failed to read response");
             break;
 
+        case HTTP_ERROR_RESPONSE_TOO_LARGE:
+            ESP_LOGE(TAG, "Response larger than %d bytes", BUFFER_SIZE);
+            break;
+
+        case HTTP_ERROR_STATUS:
+            break;
+
         default:
             ESP_LOGE(TAG, "An unknown error occurred");
             break;
     }
     ESP_LOGI(TAG, "Post api_check_word Switch Statement");
     //esp_http_client_cleanup(client);
-    return ESP_OK;
+    return ret;
 }
 
 esp_err_t api_client_init(void){
 
-    response.buffer_size = BUFFER_SIZE; // Initial buffer size
-    response.buffer = malloc(response.buffer_size);
-    if (response.buffer == NULL) {
-        ESP_LOGE(TAG, "Failed to allocate memory for response buffer");
-        return ESP_ERR_NO_MEM;
-    }
     response.data_length = 0;
     response.buffer[0] = '\0';
 
+#ifdef CONFIG_API_JSON_PARSER_CJSON
+    cjson_arena_init();
+#endif
+
     // Configure the HTTP client
-    config.url = "https://wordle-game-api1.p.rapidapi.com";
+    config.url = GET_WORD_URL;  // Every request sets its own URL, this only picks the host
     config.cert_pem = root_cert;
     config.buffer_size = BUFFER_SIZE;
+    config.event_handler = http_event_handler;
+    // The connection is reused because the handle stays open between requests.
+    // TCP keepalive probes only notice when an idle connection has been dropped
+    // (e.g. by a NAT timeout), so the next guess reconnects instead of stalling.
+    config.keep_alive_enable = true;
+#ifdef CONFIG_ESP_TLS_CLIENT_SESSION_TICKETS
+    config.save_client_session = true;  // Resume with a session ticket when reconnecting
+#endif
 
     client = esp_http_client_init(&config);
     if (!client) {
         ESP_LOGE(TAG, "Failed to initialize HTTP client handle");
-        free(response.buffer);
         return ESP_FAIL;
     }
     // Set the request headers
@@ -256,44 +489,51 @@ esp_err_t api_client_init(void){
     return ESP_OK;
 }
 
-static void extract_word(const char *json_string, size_t json_size, char *word_buffer, size_t buffer_size) {
-    cJSON *root = cJSON_ParseWithLength(json_string, json_size);
-    if (root == NULL) {
-        // Handle JSON parsing error
-        word_buffer[0] = '\0';
-        return;
-    }
-
-    cJSON *word_item = cJSON_GetObjectItem(root, "word");
-    if (cJSON_IsString(word_item) && (word_item->valuestring != NULL)) {
-        // Copy the "word" value into the provided buffer
-        strncpy(word_buffer, word_item->valuestring, buffer_size - 1);
-        word_buffer[buffer_size - 1] = '\0';  // Ensure null-termination
-    } else {
-        // "word" item not found or not a string
-        word_buffer[0] = '\0';
-    }
+static bool extract_word(const char *json_string, size_t json_size, char *word_buffer, size_t buffer_size) {
+    return extract_string_field(json_string, json_size, API_ENDPOINT_WORD, "word", word_buffer, buffer_size);
+}
 
-    cJSON_Delete(root);
+static bool extract_result(const char *json_string, size_t json_size, char *word_buffer, size_t buffer_size) {
+    return extract_string_field(json_string, json_size, API_ENDPOINT_GUESS, "result", word_buffer, buffer_size);
 }
 
-static void extract_result(const char *json_string, size_t json_size, char *word_buffer, size_t buffer_size) {
-    cJSON *root = cJSON_ParseWithLength(json_string, json_size);
-    if (root == NULL) {
-        // Handle JSON parsing error
-        word_buffer[0] = '\0';
-        return;
-    }
+#ifdef CONFIG_API_JSON_PARSER_CJSON
+static bool extract_string_field(const char *json_string, size_t json_size, api_endpoint_t endpoint, const char *field, char *buffer, size_t buffer_size) {
+    bool found = false;
 
-    cJSON *word_item = cJSON_GetObjectItem(root, "result");
-    if (cJSON_IsString(word_item) && (word_item->valuestring != NULL)) {
-        // Copy the "word" value into the provided buffer
-        strncpy(word_buffer, word_item->valuestring, buffer_size - 1);
-        word_buffer[buffer_size - 1] = '\0';  // Ensure null-termination
+    // The whole tree lives in the arena and is dropped at once when the scope ends
+    cjson_arena_begin(endpoint);
+
+    cJSON *root = cJSON_ParseWithLength(json_string, json_size);
+    cJSON *item = cJSON_GetObjectItem(root, field);
+    if (cJSON_IsString(item) && (item->valuestring != NULL)) {
+        // Copy the value into the provided buffer
+        strncpy(buffer, item->valuestring, buffer_size - 1);
+        buffer[buffer_size - 1] = '\0';  // Ensure null-termination
+        found = true;
     } else {
-        // "word" item not found or not a string
-        word_buffer[0] = '\0';
+        // Parse error, field not found or not a string
+        buffer[0] = '\0';
     }
 
-    cJSON_Delete(root);
-}
\ No newline at end of file
+    // Only the parts that spilled to the heap need freeing
+    if (cjson_arena_used_heap()) {
+        ESP_LOGW(TAG, "cJSON arena too small for \"%s\" response", field);
+        cJSON_Delete(root);
+    }
+    if (cjson_arena_end()) {
+        ESP_LOGI(TAG, "cJSON arena high-water for \"%s\": %u of %d bytes",
+                 field, (unsigned)cjson_arena_peak(endpoint), CJSON_ARENA_SIZE);
+    }
+    return found;
+}
+#else
+static bool extract_string_field(const char *json_string, size_t json_size, api_endpoint_t endpoint, const char *field, char *buffer, size_t buffer_size) {
+    // Zero-allocation single pass scan, leaves the buffer empty on failure
+    if (!json_extract_string(json_string, json_size, field, buffer, buffer_size)) {
+        ESP_LOGW(TAG, "Field \"%s\" not found in response", field);
+        return false;
+    }
+    return true;
+}
+#endif
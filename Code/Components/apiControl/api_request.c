@@ -0,0 +1,217 @@
+#include <string.h>
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "api_client.h"
+#include "api_request.h"
+
+#define WORD_SIZE 6
+#define REQUEST_POOL_SIZE 4
+#define WORKER_STACK_SIZE 8192  // TLS handshakes need a deep stack
+#define WORKER_PRIORITY 5
+
+typedef enum {
+    REQUEST_FREE = 0,
+    REQUEST_QUEUED,
+    REQUEST_RUNNING,
+    REQUEST_DONE
+} request_state_t;
+
+typedef enum {
+    REQUEST_GET_WORD,
+    REQUEST_GET_NEXT_WORD,
+    REQUEST_CHECK_WORD
+} request_type_t;
+
+struct api_request {
+    request_type_t type;
+    volatile request_state_t state;
+    volatile bool cancelled;
+    esp_err_t err;
+    char data[WORD_SIZE];           // Guess in, word or result pattern out
+    SemaphoreHandle_t done;
+    StaticSemaphore_t done_buffer;
+};
+
+static const char *TAG = "api_request";
+static struct api_request requests[REQUEST_POOL_SIZE];
+static QueueHandle_t request_queue;
+static portMUX_TYPE request_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static void api_worker_task(void *arg) {
+    api_request_handle_t request;
+    char data[WORD_SIZE];
+    esp_err_t err;
+
+    for (;;) {
+        if (xQueueReceive(request_queue, &request, portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+
+        taskENTER_CRITICAL(&request_lock);
+        bool cancelled = request->cancelled;
+        if (cancelled) {
+            request->state = REQUEST_FREE;
+        } else {
+            request->state = REQUEST_RUNNING;
+            memcpy(data, request->data, sizeof(data));
+        }
+        taskEXIT_CRITICAL(&request_lock);
+
+        if (cancelled) {
+            continue;
+        }
+
+        if (request->type == REQUEST_GET_WORD) {
+            data[0] = '\0';
+            err = api_get_word(data, sizeof(data));
+        } else if (request->type == REQUEST_GET_NEXT_WORD) {
+            data[0] = '\0';
+            err = api_get_next_word(data, sizeof(data));
+        } else {
+            err = api_check_word(data, sizeof(data));
+        }
+        // The api calls leave an empty string behind when the response could not be parsed
+        if (err == ESP_OK && data[0] == '\0') {
+            err = ESP_FAIL;
+        }
+
+        taskENTER_CRITICAL(&request_lock);
+        bool finished = !request->cancelled;
+        if (finished) {
+            memcpy(request->data, data, sizeof(data));
+            request->err = err;
+            request->state = REQUEST_DONE;
+        } else {
+            request->state = REQUEST_FREE;
+        }
+        taskEXIT_CRITICAL(&request_lock);
+
+        if (finished) {
+            xSemaphoreGive(request->done);
+        }
+    }
+}
+
+static api_request_handle_t submit_request(request_type_t type, const char *data) {
+    api_request_handle_t request = NULL;
+
+    taskENTER_CRITICAL(&request_lock);
+    for (int i = 0; i < REQUEST_POOL_SIZE; i++) {
+        if (requests[i].state == REQUEST_FREE) {
+            request = &requests[i];
+            request->state = REQUEST_QUEUED;
+            break;
+        }
+    }
+    taskEXIT_CRITICAL(&request_lock);
+
+    if (request == NULL) {
+        ESP_LOGE(TAG, "No free request slot");
+        return NULL;
+    }
+
+    request->type = type;
+    request->cancelled = false;
+    request->err = ESP_OK;
+    memset(request->data, 0, sizeof(request->data));
+    if (data != NULL) {
+        strncpy(request->data, data, sizeof(request->data) - 1);
+    }
+    // Clear a completion left over from the slot's previous use
+    xSemaphoreTake(request->done, 0);
+
+    if (xQueueSend(request_queue, &request, 0) != pdTRUE) {
+        ESP_LOGE(TAG, "Request queue full");
+        request->state = REQUEST_FREE;
+        return NULL;
+    }
+    return request;
+}
+
+esp_err_t api_request_init(void) {
+    for (int i = 0; i < REQUEST_POOL_SIZE; i++) {
+        requests[i].state = REQUEST_FREE;
+        requests[i].done = xSemaphoreCreateBinaryStatic(&requests[i].done_buffer);
+    }
+
+    request_queue = xQueueCreate(REQUEST_POOL_SIZE, sizeof(api_request_handle_t));
+    if (request_queue == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    if (xTaskCreate(api_worker_task, "api_worker", WORKER_STACK_SIZE, NULL, WORKER_PRIORITY, NULL) != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create API worker task");
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
+
+api_request_handle_t api_request_get_word(void) {
+    return submit_request(REQUEST_GET_WORD, NULL);
+}
+
+api_request_handle_t api_request_get_next_word(void) {
+    return submit_request(REQUEST_GET_NEXT_WORD, NULL);
+}
+
+api_request_handle_t api_request_check_word(const char *guess) {
+    if (guess == NULL) {
+        return NULL;
+    }
+    return submit_request(REQUEST_CHECK_WORD, guess);
+}
+
+api_request_status_t api_request_poll(api_request_handle_t handle) {
+    return (handle != NULL && handle->state == REQUEST_DONE) ? API_REQUEST_DONE : API_REQUEST_PENDING;
+}
+
+esp_err_t api_request_wait(api_request_handle_t handle, uint32_t timeout_ms) {
+    if (handle == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (handle->state == REQUEST_DONE) {
+        return ESP_OK;
+    }
+    if (xSemaphoreTake(handle->done, pdMS_TO_TICKS(timeout_ms)) == pdTRUE && handle->state == REQUEST_DONE) {
+        return ESP_OK;
+    }
+    return ESP_ERR_TIMEOUT;
+}
+
+esp_err_t api_request_take(api_request_handle_t handle, char *result, int result_size) {
+    esp_err_t err;
+
+    if (handle == NULL || result == NULL || result_size <= 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    taskENTER_CRITICAL(&request_lock);
+    if (handle->state != REQUEST_DONE) {
+        taskEXIT_CRITICAL(&request_lock);
+        return ESP_ERR_INVALID_STATE;
+    }
+    err = handle->err;
+    strlcpy(result, handle->data, result_size);
+    handle->state = REQUEST_FREE;
+    taskEXIT_CRITICAL(&request_lock);
+
+    return err;
+}
+
+void api_request_cancel(api_request_handle_t handle) {
+    if (handle == NULL) {
+        return;
+    }
+
+    taskENTER_CRITICAL(&request_lock);
+    if (handle->state == REQUEST_DONE) {
+        handle->state = REQUEST_FREE;
+    } else if (handle->state != REQUEST_FREE) {
+        // The worker frees the slot once it picks it up or finishes it
+        handle->cancelled = true;
+    }
+    taskEXIT_CRITICAL(&request_lock);
+}
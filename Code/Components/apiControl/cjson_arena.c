@@ -0,0 +1,78 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include "cJSON.h"
+#include "cjson_arena.h"
+
+#define ARENA_ALIGNMENT 8
+
+typedef struct {
+    _Alignas(ARENA_ALIGNMENT) uint8_t buffer[CJSON_ARENA_SIZE];
+    size_t used;
+    bool in_scope;
+    bool used_heap;
+    unsigned scope;
+    size_t peak[CJSON_ARENA_MAX_SCOPES];
+} cjson_arena_t;
+
+static cjson_arena_t arena;
+
+static bool in_arena(const void *ptr) {
+    return (const uint8_t *)ptr >= arena.buffer && (const uint8_t *)ptr < arena.buffer + CJSON_ARENA_SIZE;
+}
+
+static void *arena_malloc(size_t size) {
+    size_t aligned = (size + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1);
+
+    if (arena.in_scope && aligned <= CJSON_ARENA_SIZE - arena.used) {
+        void *ptr = &arena.buffer[arena.used];
+        arena.used += aligned;
+        return ptr;
+    }
+
+    if (arena.in_scope) {
+        arena.used_heap = true;
+    }
+    return malloc(size);
+}
+
+static void arena_free(void *ptr) {
+    // Arena memory is only released as a whole at the end of the scope
+    if (!in_arena(ptr)) {
+        free(ptr);
+    }
+}
+
+void cjson_arena_init(void) {
+    cJSON_Hooks hooks = {
+        .malloc_fn = arena_malloc,
+        .free_fn = arena_free
+    };
+    cJSON_InitHooks(&hooks);
+}
+
+void cjson_arena_begin(unsigned scope) {
+    arena.scope = scope < CJSON_ARENA_MAX_SCOPES ? scope : CJSON_ARENA_MAX_SCOPES - 1;
+    arena.used = 0;
+    arena.used_heap = false;
+    arena.in_scope = true;
+}
+
+bool cjson_arena_end(void) {
+    bool new_peak = arena.used > arena.peak[arena.scope];
+
+    if (new_peak) {
+        arena.peak[arena.scope] = arena.used;
+    }
+    arena.used = 0;
+    arena.in_scope = false;
+
+    return new_peak;
+}
+
+bool cjson_arena_used_heap(void) {
+    return arena.used_heap;
+}
+
+size_t cjson_arena_peak(unsigned scope) {
+    return scope < CJSON_ARENA_MAX_SCOPES ? arena.peak[scope] : 0;
+}
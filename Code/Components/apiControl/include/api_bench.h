@@ -0,0 +1,18 @@
+#ifndef API_BENCH_H
+#define API_BENCH_H
+
+#include "esp_err.h"
+
+/**
+ * @brief Drives the API client with a series of word and guess requests and logs
+ * latency percentiles and failure counts.
+ *
+ * Meant to be run against the mock server in Code/tools (see CONFIG_API_GET_WORD_URL),
+ * with latency, errors and truncated bodies injected on the server side.
+ *
+ * @param request_count Number of requests to send, alternating between the two endpoints.
+ * @return esp_err_t ESP_OK when the bench ran, ESP_ERR_NO_MEM if the sample buffer could not be allocated.
+ */
+esp_err_t api_bench_run(int request_count);
+
+#endif // API_BENCH_H
@@ -4,7 +4,12 @@
 #include "esp_err.h"
 
 // Function prototype for sending a POST request to an API endpoint
+// Both return ESP_FAIL when the request itself failed
 esp_err_t api_get_word(char* word, int word_size);
+// The api has no date parameter, tomorrow's word is today's word one timezone further east.
+// That only holds within this many seconds of midnight, earlier it gives ESP_ERR_INVALID_STATE
+#define API_NEXT_WORD_WINDOW_S 3600
+esp_err_t api_get_next_word(char* word, int word_size);
 esp_err_t api_check_word(char* guess, int guess_size);
 esp_err_t api_client_init(void);
 
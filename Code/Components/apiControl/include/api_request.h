@@ -0,0 +1,88 @@
+#ifndef API_REQUEST_H
+#define API_REQUEST_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+// Handle to a request running on the API worker task
+typedef struct api_request *api_request_handle_t;
+
+typedef enum {
+    API_REQUEST_PENDING = 0,    // Queued or in flight
+    API_REQUEST_DONE            // Result ready, collect it with api_request_take
+} api_request_status_t;
+
+/**
+ * @brief Starts the worker task that runs API requests in the background.
+ *
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NO_MEM if the task or queue could not be created.
+ */
+esp_err_t api_request_init(void);
+
+/**
+ * @brief Queues an api_get_word request.
+ *
+ * @return Handle to the request, NULL if no request slot is free.
+ */
+api_request_handle_t api_request_get_word(void);
+
+/**
+ * @brief Queues an api_get_next_word request, tomorrow's word.
+ *        Fails unless it runs within API_NEXT_WORD_WINDOW_S of midnight.
+ *
+ * @return Handle to the request, NULL if no request slot is free.
+ */
+api_request_handle_t api_request_get_next_word(void);
+
+/**
+ * @brief Queues an api_check_word request.
+ *
+ * @param guess The guessed word (5 letters).
+ * @return Handle to the request, NULL if no request slot is free.
+ */
+api_request_handle_t api_request_check_word(const char *guess);
+
+/**
+ * @brief Checks whether a request has finished, without blocking.
+ *
+ * @param handle The request.
+ * @return api_request_status_t Status of the request.
+ */
+api_request_status_t api_request_poll(api_request_handle_t handle);
+
+/**
+ * @brief Waits for a request to finish.
+ *
+ * @param handle The request.
+ * @param timeout_ms How long to wait, 0 to poll.
+ * @return esp_err_t ESP_OK if the request finished, ESP_ERR_TIMEOUT otherwise.
+ */
+esp_err_t api_request_wait(api_request_handle_t handle, uint32_t timeout_ms);
+
+/**
+ * @brief Copies out the result of a finished request and releases the handle.
+ *
+ * The result is the word for api_request_get_word and the result pattern for
+ * api_request_check_word. The handle must not be used afterwards.
+ *
+ * @param handle The finished request.
+ * @param result Buffer for the null terminated result.
+ * @param result_size Size of the result buffer.
+ * @return esp_err_t ESP_OK if a result was copied, ESP_ERR_INVALID_STATE if the request
+ *                   has not finished, ESP_FAIL if the request itself failed.
+ */
+esp_err_t api_request_take(api_request_handle_t handle, char *result, int result_size);
+
+/**
+ * @brief Cancels a request and releases the handle.
+ *
+ * A queued request is dropped. A request already in flight runs to completion on
+ * the worker (bounded by the HTTP client timeout) and its result is discarded.
+ * The handle must not be used afterwards.
+ *
+ * @param handle The request.
+ */
+void api_request_cancel(api_request_handle_t handle);
+
+#endif // API_REQUEST_H
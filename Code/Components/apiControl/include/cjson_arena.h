@@ -0,0 +1,52 @@
+#ifndef CJSON_ARENA_H
+#define CJSON_ARENA_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#define CJSON_ARENA_SIZE        2048    // Bytes, enough for any API response tree
+#define CJSON_ARENA_MAX_SCOPES  4       // Separate high-water marks kept per scope
+
+/**
+ * @brief Installs the arena as cJSON's allocator through cJSON_InitHooks.
+ *
+ * Outside of a scope allocations go straight to the heap, so other cJSON users are
+ * not affected.
+ */
+void cjson_arena_init(void);
+
+/**
+ * @brief Starts a scope, all cJSON allocations until cjson_arena_end come from the arena.
+ *
+ * Allocations that don't fit fall back to the heap.
+ *
+ * @param scope Index the high-water mark is tracked under (< CJSON_ARENA_MAX_SCOPES).
+ */
+void cjson_arena_begin(unsigned scope);
+
+/**
+ * @brief Ends the scope and releases everything allocated in the arena at once.
+ *
+ * Trees parsed in the scope don't need cJSON_Delete unless
+ * cjson_arena_used_heap() returned true.
+ *
+ * @return true if this scope set a new high-water mark.
+ */
+bool cjson_arena_end(void);
+
+/**
+ * @brief Whether the current scope had to fall back to the heap.
+ *
+ * @return true if cJSON_Delete is needed to free the heap part of the tree.
+ */
+bool cjson_arena_used_heap(void);
+
+/**
+ * @brief Peak arena usage seen for a scope.
+ *
+ * @param scope Scope index.
+ * @return Peak bytes used in a single scope.
+ */
+size_t cjson_arena_peak(unsigned scope);
+
+#endif // CJSON_ARENA_H
@@ -0,0 +1,24 @@
+#ifndef JSON_EXTRACT_H
+#define JSON_EXTRACT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @brief Finds a top-level string field in a JSON object and copies out its value.
+ *
+ * Single pass over the buffer with no heap allocation. Escapes (including \uXXXX)
+ * are decoded into UTF-8. Nested objects and arrays are skipped, so only keys of
+ * the outermost object can match. Malformed or truncated input never reads past
+ * json_size and simply returns false.
+ *
+ * @param json The JSON text (does not need to be null terminated).
+ * @param json_size Number of bytes in json.
+ * @param key The field name to look for (exact match).
+ * @param value Buffer for the null terminated value.
+ * @param value_size Size of the value buffer.
+ * @return true if the field was found, is a string and fits in the buffer.
+ */
+bool json_extract_string(const char *json, size_t json_size, const char *key, char *value, size_t value_size);
+
+#endif // JSON_EXTRACT_H
@@ -0,0 +1,312 @@
+#include <stdint.h>
+#include <string.h>
+#include "json_extract.h"
+
+#define MAX_NESTING_DEPTH 32
+
+typedef struct {
+    const char *json;
+    size_t size;
+    size_t pos;
+} json_scanner_t;
+
+static bool at_end(const json_scanner_t *scanner) {
+    return scanner->pos >= scanner->size || scanner->json[scanner->pos] == '\0';
+}
+
+static void skip_whitespace(json_scanner_t *scanner) {
+    while (!at_end(scanner)) {
+        char c = scanner->json[scanner->pos];
+        if (c != ' ' && c != '\t' && c != '\n' && c != '\r') {
+            break;
+        }
+        scanner->pos++;
+    }
+}
+
+static int hex_value(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if ((c | 0x20) >= 'a' && (c | 0x20) <= 'f') {
+        return (c | 0x20) - 'a' + 10;
+    }
+    return -1;
+}
+
+static bool read_hex4(json_scanner_t *scanner, uint32_t *code) {
+    *code = 0;
+    for (int i = 0; i < 4; i++) {
+        if (at_end(scanner)) {
+            return false;
+        }
+        int digit = hex_value(scanner->json[scanner->pos++]);
+        if (digit < 0) {
+            return false;
+        }
+        *code = (*code << 4) | digit;
+    }
+    return true;
+}
+
+/**
+ * @brief Decodes the next character of a string (scanner is past the opening quote).
+ *
+ * @param scanner The scanner.
+ * @param utf8 Receives the character as 1 - 4 UTF-8 bytes.
+ * @param length Receives the number of bytes, 0 when the closing quote was reached.
+ * @return false on malformed or truncated input.
+ */
+static bool next_string_char(json_scanner_t *scanner, char *utf8, size_t *length) {
+    uint32_t code;
+
+    if (at_end(scanner)) {
+        return false;
+    }
+
+    char c = scanner->json[scanner->pos++];
+    if (c == '"') {
+        *length = 0;
+        return true;
+    }
+    if ((unsigned char)c < 0x20) {
+        return false;
+    }
+    if (c != '\\') {
+        utf8[0] = c;
+        *length = 1;
+        return true;
+    }
+
+    if (at_end(scanner)) {
+        return false;
+    }
+    c = scanner->json[scanner->pos++];
+    switch (c) {
+        case '"': case '\\': case '/': code = c; break;
+        case 'b': code = '\b'; break;
+        case 'f': code = '\f'; break;
+        case 'n': code = '\n'; break;
+        case 'r': code = '\r'; break;
+        case 't': code = '\t'; break;
+        case 'u':
+            if (!read_hex4(scanner, &code)) {
+                return false;
+            }
+            // Surrogate pair, the low half must follow as another \u escape
+            if (code >= 0xD800 && code <= 0xDBFF) {
+                uint32_t low;
+                if (scanner->pos + 2 > scanner->size || scanner->json[scanner->pos] != '\\' ||
+                    scanner->json[scanner->pos + 1] != 'u') {
+                    return false;
+                }
+                scanner->pos += 2;
+                if (!read_hex4(scanner, &low) || low < 0xDC00 || low > 0xDFFF) {
+                    return false;
+                }
+                code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+            } else if (code >= 0xDC00 && code <= 0xDFFF) {
+                return false;
+            }
+            break;
+        default:
+            return false;
+    }
+
+    if (code < 0x80) {
+        utf8[0] = (char)code;
+        *length = 1;
+    } else if (code < 0x800) {
+        utf8[0] = (char)(0xC0 | (code >> 6));
+        utf8[1] = (char)(0x80 | (code & 0x3F));
+        *length = 2;
+    } else if (code < 0x10000) {
+        utf8[0] = (char)(0xE0 | (code >> 12));
+        utf8[1] = (char)(0x80 | ((code >> 6) & 0x3F));
+        utf8[2] = (char)(0x80 | (code & 0x3F));
+        *length = 3;
+    } else {
+        utf8[0] = (char)(0xF0 | (code >> 18));
+        utf8[1] = (char)(0x80 | ((code >> 12) & 0x3F));
+        utf8[2] = (char)(0x80 | ((code >> 6) & 0x3F));
+        utf8[3] = (char)(0x80 | (code & 0x3F));
+        *length = 4;
+    }
+    return true;
+}
+
+/**
+ * @brief Scans a string (scanner is past the opening quote), optionally comparing or copying it.
+ *
+ * @param scanner The scanner.
+ * @param compare If not NULL, *matches is set to whether the string equals it.
+ * @param matches Comparison result.
+ * @param out If not NULL, the decoded string is copied here.
+ * @param out_size Size of out.
+ * @return false on malformed input or if the string does not fit in out.
+ */
+static bool scan_string(json_scanner_t *scanner, const char *compare, bool *matches, char *out, size_t out_size) {
+    char utf8[4];
+    size_t length;
+    size_t written = 0;
+    bool fits = true;
+
+    if (compare != NULL) {
+        *matches = true;
+    }
+
+    for (;;) {
+        if (!next_string_char(scanner, utf8, &length)) {
+            return false;
+        }
+        if (length == 0) {
+            break;
+        }
+        // Stops at the first difference, so compare is never read past its terminator
+        for (size_t i = 0; compare != NULL && *matches && i < length; i++) {
+            if (utf8[i] == '\0' || compare[written + i] != utf8[i]) {
+                *matches = false;
+            }
+        }
+        if (out != NULL) {
+            if (written + length < out_size) {
+                memcpy(out + written, utf8, length);
+            } else {
+                fits = false;
+            }
+        }
+        written += length;
+    }
+
+    if (compare != NULL && *matches && compare[written] != '\0') {
+        *matches = false;
+    }
+    if (out != NULL) {
+        if (!fits) {
+            return false;
+        }
+        out[written] = '\0';
+    }
+    return true;
+}
+
+/**
+ * @brief Skips any JSON value, including nested objects and arrays.
+ *
+ * Nesting is only checked for balanced brackets, which is enough to find the next
+ * top-level key safely.
+ */
+static bool skip_value(json_scanner_t *scanner) {
+    char closers[MAX_NESTING_DEPTH];
+    int depth = 0;
+
+    do {
+        skip_whitespace(scanner);
+        if (at_end(scanner)) {
+            return false;
+        }
+
+        char c = scanner->json[scanner->pos];
+        if (c == '"') {
+            scanner->pos++;
+            if (!scan_string(scanner, NULL, NULL, NULL, 0)) {
+                return false;
+            }
+        } else if (c == '{' || c == '[') {
+            if (depth == MAX_NESTING_DEPTH) {
+                return false;
+            }
+            closers[depth++] = (c == '{') ? '}' : ']';
+            scanner->pos++;
+        } else if (c == '}' || c == ']') {
+            if (depth == 0 || closers[depth - 1] != c) {
+                return false;
+            }
+            depth--;
+            scanner->pos++;
+        } else if (c == ',' || c == ':') {
+            if (depth == 0) {
+                return false;
+            }
+            scanner->pos++;
+        } else {
+            // Number or literal, runs until the next delimiter
+            size_t start = scanner->pos;
+            while (!at_end(scanner)) {
+                c = scanner->json[scanner->pos];
+                if (c == ',' || c == '}' || c == ']' || c == ':' || c == ' ' ||
+                    c == '\t' || c == '\n' || c == '\r' || c == '"') {
+                    break;
+                }
+                scanner->pos++;
+            }
+            if (scanner->pos == start) {
+                return false;
+            }
+        }
+    } while (depth > 0);
+
+    return true;
+}
+
+bool json_extract_string(const char *json, size_t json_size, const char *key, char *value, size_t value_size) {
+    json_scanner_t scanner = { .json = json, .size = json_size, .pos = 0 };
+    bool matches;
+
+    if (json == NULL || key == NULL || value == NULL || value_size == 0) {
+        return false;
+    }
+    value[0] = '\0';
+
+    skip_whitespace(&scanner);
+    if (at_end(&scanner) || json[scanner.pos++] != '{') {
+        return false;
+    }
+
+    for (;;) {
+        skip_whitespace(&scanner);
+        if (at_end(&scanner)) {
+            return false;
+        }
+        if (json[scanner.pos] == '}') {
+            return false;   // Key not in the object
+        }
+        if (json[scanner.pos++] != '"' || !scan_string(&scanner, key, &matches, NULL, 0)) {
+            return false;
+        }
+
+        skip_whitespace(&scanner);
+        if (at_end(&scanner) || json[scanner.pos++] != ':') {
+            return false;
+        }
+        skip_whitespace(&scanner);
+        if (at_end(&scanner)) {
+            return false;
+        }
+
+        if (matches) {
+            if (json[scanner.pos++] != '"') {
+                return false;   // Present but not a string
+            }
+            if (!scan_string(&scanner, NULL, NULL, value, value_size)) {
+                value[0] = '\0';
+                return false;
+            }
+            return true;
+        }
+
+        if (!skip_value(&scanner)) {
+            return false;
+        }
+
+        skip_whitespace(&scanner);
+        if (at_end(&scanner)) {
+            return false;
+        }
+        if (json[scanner.pos] == ',') {
+            scanner.pos++;
+        } else if (json[scanner.pos] != '}') {
+            return false;
+        }
+    }
+}
@@ -99,7 +99,7 @@ esp_err_t initGPIO()
     }
     
     //create a queue to handle gpio event from isr
-    gpioEventQueue = xQueueCreate(10, sizeof(uint32_t));
+    gpioEventQueue = xQueueCreate(GPIO_EVENT_QUEUE_LENGTH, sizeof(uint32_t));
 
     //install gpio isr service
     ret |= gpio_install_isr_service(ESP_INTR_FLAG_DEFAULT);
@@ -20,6 +20,9 @@
 #define GPIO_BTN_C_LED 18
 #define GPIO_BTN_D_LED 8
 
+// Button presses waiting to be handled
+#define GPIO_EVENT_QUEUE_LENGTH 10
+
 extern QueueHandle_t gpioEventQueue;
 
 /*
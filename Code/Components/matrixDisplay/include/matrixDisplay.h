@@ -1,5 +1,6 @@
 #pragma once
 
+#include <stdbool.h>
 #include <esp_err.h>
 
 #define CASCADE_SIZE 5  // Number of cascaded MAX7219 modules in a display
@@ -67,6 +68,16 @@ typedef enum
 
 } symbols_t;
 
+// Line drawn in the blank bottom row of a segment, under the symbol
+typedef enum
+{
+    NO_UNDERLINE,
+    DOTTED_UNDERLINE,
+    SOLID_UNDERLINE,
+
+    UNDERLINE_COUNT
+} underline_t;
+
 extern uint64_t segmentStates[NUM_DISPLAYS][CASCADE_SIZE];
 
 
@@ -141,6 +152,20 @@ esp_err_t display_init(void);
 void enableCursor(void);
 
 
+/*
+* Description:
+*      Returns whether the cursor is enabled
+* 
+* Arguments:
+*     None
+* 
+* Returns:
+*      True if the cursor is enabled
+*      False if the cursor is disabled
+*/
+bool isCursorEnabled(void);
+
+
 /*
 * Description:
 *      Returns the character at the cursor
@@ -168,6 +193,37 @@ char getCharAtCursor(void);
 uint8_t getCursorPos(void);
 
 
+/*
+* Description:
+*      Shows a number on a display, right aligned with blank segments in front
+*      Numbers too big for the display show as all nines
+* 
+* Arguments:
+*     display_t display: The display to draw on (LOWER_DISPLAY or UPPER_DISPLAY)
+*     uint32_t number: The number to show
+* 
+* Returns:
+*      esp_err_t: ESP_OK if the number was drawn successfully
+*/
+esp_err_t displayNumber(display_t display, uint32_t number);
+
+
+/*
+* Description:
+*      Copies the current graphics of every segment of a display
+*      Used together with setDisplayState to put a display back
+*      after temporarily drawing over it
+* 
+* Arguments:
+*     display_t display: The display to read (LOWER_DISPLAY or UPPER_DISPLAY)
+*     uint64_t *state: Array of CASCADE_SIZE graphics to fill
+* 
+* Returns:
+*      esp_err_t: ESP_OK if the state was copied successfully
+*/
+esp_err_t getDisplayState(display_t display, uint64_t *state);
+
+
 /*
 * Description:
 *      returns a null terminated string of characters from the top display
@@ -246,6 +302,21 @@ esp_err_t resetCursor(void);
 */
 void setBrightness(uint8_t brightness);
 
+/*
+* Description:
+*      Draws previously saved graphics (see getDisplayState) on every
+*      segment of a display
+*      The graphics are drawn as is, a saved cursor is restored with them
+* 
+* Arguments:
+*     display_t display: The display to draw (LOWER_DISPLAY or UPPER_DISPLAY)
+*     const uint64_t *state: Array of CASCADE_SIZE graphics
+* 
+* Returns:
+*      esp_err_t: ESP_OK if the state was drawn successfully
+*/
+esp_err_t setDisplayState(display_t display, const uint64_t *state);
+
 /*
 * Description:
 *      sets the segment to the symbol
@@ -260,6 +331,46 @@ void setBrightness(uint8_t brightness);
 */
 esp_err_t setSymbol(symbols_t symbol, display_t display, uint8_t charPos);
 
+/*
+* Description:
+*      sets the segment to the symbol with a line under it
+*      getCharAtCursor and getWord still read the symbol
+* 
+* Arguments:
+*     symbols_t symbol: The symbol to display
+*     display_t display: The display to set the symbol
+*     uint8_t charPos: The segment to display the symbol (zero indexed)
+*     underline_t underline: The line to draw under the symbol
+* 
+* Returns:
+*      esp_err_t: ESP_OK if the symbol was set successfully
+*/
+esp_err_t setUnderlinedSymbol(symbols_t symbol, display_t display, uint8_t charPos, underline_t underline);
+
+/*
+* Description:
+*      Slides a symbol onto a run of segments a pixel column at a time
+*      The symbols on the run move one segment over, away from the side the
+*      new one comes in on, and the one on the far end slides off
+*      Each frame is drawn to the whole display at once, a cursor on the
+*      run stays on its segment
+* 
+* Arguments:
+*     symbols_t symbol: The symbol to slide in
+*     underline_t underline: The line to draw under it
+*     display_t display: The display (LOWER_DISPLAY or UPPER_DISPLAY)
+*     uint8_t firstPos: The leftmost segment of the run
+*     uint8_t lastPos: The rightmost segment of the run
+*     direction_t direction: LEFT to slide in on firstPos, RIGHT on lastPos
+*     uint8_t frames: Frames to take (1 - 8), 1 jumps straight to the end
+*     uint32_t frameMs: Time between frames
+* 
+* Returns:
+*      esp_err_t: ESP_OK if the symbol was slid in successfully
+*/
+esp_err_t slideInSymbol(symbols_t symbol, underline_t underline, display_t display, uint8_t firstPos, uint8_t lastPos,
+                        direction_t direction, uint8_t frames, uint32_t frameMs);
+
 /*
 * Description:
 *      Toggle the cursor off
@@ -59,6 +59,21 @@ const graphicSymbolMap_t graphicSymbolMap[] = {
 };
 static_assert(TOTAL_NUM_OF_SYMBOLS == (sizeof(graphicSymbolMap) / sizeof(graphicSymbolMap_t)), "TOTAL_NUM_OF_SYMBOLS does not match the number of elements in graphicSymbolMap");
 
+// 0 - 9 (MUST BE IN ORDER)
+const uint64_t digitGraphics[] = {
+    0x003e676f7b73633e,
+    0x003f0c0c0c0c0e0c,
+    0x003f33061c30331e,
+    0x001e33301c30331e,
+    0x0078307f33363c38,
+    0x001e3330301f033f,
+    0x001e33331f03061c,
+    0x000c0c0c1830333f,
+    0x001e33331e33331e,
+    0x000e18303e33331e
+};
+static_assert(10 == (sizeof(digitGraphics) / sizeof(uint64_t)), "digitGraphics must hold the digits 0 - 9");
+
 //WORDn\nSEEK!
 const uint64_t dispWordNSeek[] = {
     0x0063777f6b636363,
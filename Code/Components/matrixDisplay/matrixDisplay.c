@@ -21,8 +21,10 @@ Literal Constants
 #define LEFT_ARROW_SEGMENT  0
 #define RIGHT_ARROW_SEGMENT (CASCADE_SIZE - 1)
 
-#define LOG_TAG "matrix_display"
+#define SEGMENT_COLUMNS 8
+#define FIRST_COLUMN_BITS 0x0101010101010101  // Leftmost pixel of every row
 
+#define LOG_TAG "matrix_display"
 
 /*-----------------------------------------------------------
 Types
@@ -41,6 +43,18 @@ typedef struct
     bool isValid;
 } cursor_t;
 
+/*-----------------------------------------------------------
+Memory Constants
+------------------------------------------------------------*/
+
+// Bottom row of a segment, blank in every letter
+const uint64_t underlineGraphics[UNDERLINE_COUNT] = {
+    0x0000000000000000,
+    0x5500000000000000,
+    0x7f00000000000000
+};
+
+
 /*-----------------------------------------------------------
 Gobals
 ------------------------------------------------------------*/
@@ -92,6 +106,35 @@ void correctCursorPos(void);
 */
 char graphicToChar(uint64_t graphic);
 
+
+/*
+* Description:
+*      Draws every segment of a display from segmentStates in one batch
+* 
+* Arguments:
+*     display_t display: The display to draw (LOWER_DISPLAY or UPPER_DISPLAY)
+* 
+* Returns:
+*      esp_err_t: ESP_OK if the display was drawn successfully
+*/
+esp_err_t flushDisplay(display_t display);
+
+
+/*
+* Description:
+*      Gets the 8x8 window a number of columns into two graphics side by side
+*      Bit 0 of a row is its leftmost pixel
+* 
+* Arguments:
+*     uint64_t left: The graphic on the left
+*     uint64_t right: The graphic on the right
+*     uint8_t columns: How far into left the window starts (0 - 8)
+* 
+* Returns:
+*      uint64_t: The graphic in the window
+*/
+uint64_t shiftColumns(uint64_t left, uint64_t right, uint8_t columns);
+
 /*-----------------------------------------------------------
 Functions
 ------------------------------------------------------------*/
@@ -176,21 +219,30 @@ esp_err_t displayFullGraphic(const uint64_t *graphic, const int size)
     // Display starting from the top display
     for(int display = NUM_DISPLAYS - 1; display >= 0; display--)
     {
-        for(uint8_t segment = 0; segment < CASCADE_SIZE; segment++)
-        {   
-            // Draw the graphic on the display
-            ret |= max7219_draw_image_8x8(&displays[display]->dev, segment*8, &graphic[frame]);
-
-            // Save the segment state
-            segmentStates[display][segment] = graphic[frame];
+        // Save the segment states
+        memcpy(segmentStates[display], &graphic[frame], sizeof(segmentStates[display]));
+        frame += CASCADE_SIZE;
 
-            frame++;
-        }
+        // Draw the graphics on the display
+        ret |= flushDisplay(display);
     }
 
     return ret;
 }
 
+esp_err_t flushDisplay(display_t display)
+{
+    return max7219_draw_images_8x8(&displays[display]->dev, segmentStates[display]);
+}
+
+uint64_t shiftColumns(uint64_t left, uint64_t right, uint8_t columns)
+{
+    // Columns of every row that are still from the left graphic
+    uint64_t leftColumns = FIRST_COLUMN_BITS * ((1u << (SEGMENT_COLUMNS - columns)) - 1);
+
+    return ((left >> columns) & leftColumns) | ((right << (SEGMENT_COLUMNS - columns)) & ~leftColumns);
+}
+
 esp_err_t display_init(void)
 {
     cursor.isValid = false;
@@ -265,6 +317,11 @@ void enableCursor(void)
     cursor.isValid = true;
 }
 
+bool isCursorEnabled(void)
+{
+    return cursor.isValid;
+}
+
 char getCharAtCursor(void)
 {
     return graphicToChar(segmentStates[cursor.curDisplay][cursor.curSegment]);
@@ -275,6 +332,55 @@ uint8_t getCursorPos(void)
     return cursor.curSegment;
 }
 
+esp_err_t displayNumber(display_t display, uint32_t number)
+{
+    uint64_t state[CASCADE_SIZE] = {0};
+    uint32_t maxNumber = 1;
+
+    if(display >= NUM_DISPLAYS)
+    {
+        ESP_LOGE(LOG_TAG, "Invalid display");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    for(uint8_t segment = 0; segment < CASCADE_SIZE; segment++)
+    {
+        maxNumber *= 10;
+    }
+
+    if(number >= maxNumber)
+    {
+        number = maxNumber - 1;
+    }
+
+    // Fill from the right, always at least one digit
+    for(int8_t segment = CASCADE_SIZE - 1; segment >= 0; segment--)
+    {
+        state[segment] = digitGraphics[number % 10];
+        number /= 10;
+
+        if(number == 0)
+        {
+            break;
+        }
+    }
+
+    return setDisplayState(display, state);
+}
+
+esp_err_t getDisplayState(display_t display, uint64_t *state)
+{
+    if(state == NULL || display >= NUM_DISPLAYS)
+    {
+        ESP_LOGE(LOG_TAG, "Invalid display state arguments");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    memcpy(state, segmentStates[display], CASCADE_SIZE * sizeof(uint64_t));
+
+    return ESP_OK;
+}
+
 esp_err_t getWord(char *word, int wordSize)
 {
     esp_err_t ret = ESP_OK;
@@ -314,13 +420,20 @@ esp_err_t getWord(char *word, int wordSize)
 
 char graphicToChar(uint64_t graphic)
 {   
+    uint64_t symbolGraphic;
+
     // Check if graphic is a letter
     for(uint8_t index = 0; index < TOTAL_NUM_OF_SYMBOLS; index++)
     {   
-        // Also account for the inverted graphic (aka the cursor)
-        if((graphic == graphicSymbolMap[index].graphic) || (graphic == ~graphicSymbolMap[index].graphic))
+        for(uint8_t underline = 0; underline < UNDERLINE_COUNT; underline++)
         {
-            return graphicSymbolMap[index].character;
+            symbolGraphic = graphicSymbolMap[index].graphic | underlineGraphics[underline];
+
+            // Also account for the inverted graphic (aka the cursor)
+            if((graphic == symbolGraphic) || (graphic == ~symbolGraphic))
+            {
+                return graphicSymbolMap[index].character;
+            }
         }
     }
     
@@ -475,7 +588,29 @@ esp_err_t resetCursor(void)
     return ret;
 }
 
+esp_err_t setDisplayState(display_t display, const uint64_t *state)
+{
+    esp_err_t ret = ESP_OK;
+
+    if(state == NULL || display >= NUM_DISPLAYS)
+    {
+        ESP_LOGE(LOG_TAG, "Invalid display state arguments");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    memcpy(segmentStates[display], state, sizeof(segmentStates[display]));
+
+    ret |= flushDisplay(display);
+
+    return ret;
+}
+
 esp_err_t setSymbol(symbols_t symbol, display_t display, uint8_t charPos)
+{
+    return setUnderlinedSymbol(symbol, display, charPos, NO_UNDERLINE);
+}
+
+esp_err_t setUnderlinedSymbol(symbols_t symbol, display_t display, uint8_t charPos, underline_t underline)
 {
     esp_err_t ret = ESP_OK;
     uint64_t graphic = 0;
@@ -487,7 +622,13 @@ esp_err_t setSymbol(symbols_t symbol, display_t display, uint8_t charPos)
         return ESP_ERR_INVALID_ARG;
     }
 
-    graphic = graphicSymbolMap[symbol].graphic;
+    if(underline >= UNDERLINE_COUNT)
+    {
+        ESP_LOGE(LOG_TAG, "Invalid underline: %d", underline);
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    graphic = graphicSymbolMap[symbol].graphic | underlineGraphics[underline];
 
     // ESP_LOGD(LOG_TAG, "Graphic: %llx", graphic);
 
@@ -527,6 +668,65 @@ esp_err_t setSymbol(symbols_t symbol, display_t display, uint8_t charPos)
     return ret;
 }
 
+esp_err_t slideInSymbol(symbols_t symbol, underline_t underline, display_t display, uint8_t firstPos, uint8_t lastPos,
+                        direction_t direction, uint8_t frames, uint32_t frameMs)
+{
+    esp_err_t ret = ESP_OK;
+    uint64_t strip[CASCADE_SIZE + 1];
+    uint64_t cursorMask[CASCADE_SIZE] = {0};
+    uint8_t count = lastPos - firstPos + 1;
+    uint8_t columns;
+
+    if(display >= NUM_DISPLAYS || firstPos > lastPos || lastPos >= CASCADE_SIZE ||
+       (direction != LEFT && direction != RIGHT) || frames == 0 || frames > SEGMENT_COLUMNS)
+    {
+        ESP_LOGE(LOG_TAG, "Invalid slide arguments");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if(underline >= UNDERLINE_COUNT)
+    {
+        ESP_LOGE(LOG_TAG, "Invalid underline: %d", underline);
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // The cursor stays on its segment, so take it off the graphics while they move
+    if(cursor.isValid && cursor.curDisplay == display && cursor.curSegment >= firstPos && cursor.curSegment <= lastPos)
+    {
+        cursorMask[cursor.curSegment - firstPos] = ~(uint64_t)0;
+    }
+
+    // Line the run up with the new symbol on the end it comes in on
+    for(uint8_t segment = 0; segment < count; segment++)
+    {
+        strip[segment + (direction == LEFT)] = segmentStates[display][firstPos + segment] ^ cursorMask[segment];
+    }
+
+    strip[(direction == LEFT) ? 0 : count] = graphicSymbolMap[symbol].graphic | underlineGraphics[underline];
+
+    for(uint8_t frame = 1; frame <= frames; frame++)
+    {
+        columns = (frame * SEGMENT_COLUMNS) / frames;
+
+        // Moving left the window goes further into the strip, moving right it starts a segment in and backs up
+        for(uint8_t segment = 0; segment < count; segment++)
+        {
+            segmentStates[display][firstPos + segment] = cursorMask[segment] ^
+                ((direction == RIGHT) ? shiftColumns(strip[segment], strip[segment + 1], columns)
+                                      : shiftColumns(strip[segment], strip[segment + 1], SEGMENT_COLUMNS - columns));
+        }
+
+        ret |= flushDisplay(display);
+
+        if(frame < frames)
+        {
+            vTaskDelay(pdMS_TO_TICKS(frameMs));
+        }
+    }
+
+    return ret;
+}
+
 void setBrightness(uint8_t brightness)
 {
     if(brightness > MAX7219_MAX_BRIGHTNESS)
@@ -165,6 +165,18 @@ esp_err_t max7219_draw_text_7seg(max7219_t *dev, uint8_t pos, const char *s);
  */
 esp_err_t max7219_draw_image_8x8(max7219_t *dev, uint8_t pos, const void *image);
 
+/**
+ * @brief Draw 64-bit images on every 8x8 matrix of the cascade
+ *
+ * Sends one row of all the matrices per transfer, so a full frame takes
+ * 8 transfers instead of 8 per matrix
+ *
+ * @param dev Display descriptor, digits must cover the whole cascade
+ * @param images cascade_size 64-bit images, the first one for digits 0..7
+ * @return `ESP_OK` on success
+ */
+esp_err_t max7219_draw_images_8x8(max7219_t *dev, const void *images);
+
 #ifdef __cplusplus
 }
 #endif
@@ -66,6 +66,15 @@ static inline uint16_t shuffle(uint16_t val)
     return (val >> 8) | (val << 8);
 }
 
+static esp_err_t transmit(max7219_t *dev, const uint16_t *buf)
+{
+    spi_transaction_t t;
+    memset(&t, 0, sizeof(t));
+    t.length = dev->cascade_size * 16;
+    t.tx_buffer = buf;
+    return spi_device_transmit(dev->spi_dev, &t);
+}
+
 static esp_err_t send(max7219_t *dev, uint8_t chip, uint16_t value)
 {
     uint16_t buf[MAX7219_MAX_CASCADE_SIZE] = { 0 };
@@ -76,11 +85,7 @@ static esp_err_t send(max7219_t *dev, uint8_t chip, uint16_t value)
     }
     else buf[chip] = shuffle(value);
 
-    spi_transaction_t t;
-    memset(&t, 0, sizeof(t));
-    t.length = dev->cascade_size * 16;
-    t.tx_buffer = buf;
-    return spi_device_transmit(dev->spi_dev, &t);
+    return transmit(dev, buf);
 }
 
 inline static uint8_t get_char(max7219_t *dev, char c)
@@ -260,4 +265,29 @@ esp_err_t max7219_draw_image_8x8(max7219_t *dev, uint8_t pos, const void *image)
         max7219_set_digit(dev, i, *((uint8_t *)image + offs));
 
     return ESP_OK;
-}
\ No newline at end of file
+}
+
+esp_err_t max7219_draw_images_8x8(max7219_t *dev, const void *images)
+{
+    CHECK_ARG(dev && images);
+    CHECK_ARG(dev->digits == dev->cascade_size * ALL_DIGITS);
+
+    const uint8_t *rows = images;
+    uint16_t buf[MAX7219_MAX_CASCADE_SIZE] = { 0 };
+
+    // One transfer per row, carrying that row of every image
+    for (uint8_t row = 0; row < ALL_DIGITS; row++)
+    {
+        for (uint8_t image = 0; image < dev->cascade_size; image++)
+        {
+            uint8_t digit = image * ALL_DIGITS + row;
+            if (dev->mirrored)
+                digit = dev->digits - digit - 1;
+
+            buf[digit / ALL_DIGITS] = shuffle((REG_DIGIT_0 + ((uint16_t)(digit % ALL_DIGITS) << 8)) | rows[image * ALL_DIGITS + row]);
+        }
+        CHECK(transmit(dev, buf));
+    }
+
+    return ESP_OK;
+}
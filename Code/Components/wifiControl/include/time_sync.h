@@ -0,0 +1,23 @@
+#ifndef TIME_SYNC_H
+#define TIME_SYNC_H
+
+#include <stdbool.h>
+
+/**
+ * @brief Sets the local timezone and starts syncing the clock over SNTP.
+ *
+ * Call once WiFi is connected. Returns straight away, the first sync completes
+ * in the background and the clock is then kept in sync every hour.
+ *
+ * @param utc_offset_hours Local time minus UTC, in hours (8 for UTC + 8).
+ */
+void time_sync_start(int utc_offset_hours);
+
+/**
+ * @brief Checks whether the clock has been synced over SNTP since boot.
+ *
+ * @return true once the first sync completed.
+ */
+bool time_sync_is_synced(void);
+
+#endif // TIME_SYNC_H
@@ -1,10 +1,14 @@
 #ifndef WIFI_H
 #define WIFI_H
 
+#include <stdbool.h>
 #include "esp_event.h"  // Ensure this header is included for 'esp_event_base_t'
 
 
 void wifi_init_sta(void);
 void event_handler(void *arg, esp_event_base_t event_base, int32_t event_id, void *event_data);
 
+/** @brief True while the station is associated with the AP */
+bool wifi_is_connected(void);
+
 #endif // WIFI_H
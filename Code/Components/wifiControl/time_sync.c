@@ -0,0 +1,63 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <sys/time.h>
+#include "esp_log.h"
+#include "esp_idf_version.h"
+#include "esp_sntp.h"
+#include "time_sync.h"
+
+// The SNTP calls gained an esp_ prefix in IDF 5.1
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 1, 0)
+#define SNTP_SET_OPERATING_MODE(mode) esp_sntp_setoperatingmode(mode)
+#define SNTP_SET_SERVER_NAME(idx, name) esp_sntp_setservername(idx, name)
+#define SNTP_INIT() esp_sntp_init()
+#define SNTP_IS_ENABLED() esp_sntp_enabled()
+#define SNTP_MODE_POLL ESP_SNTP_OPMODE_POLL
+#else
+#define SNTP_SET_OPERATING_MODE(mode) sntp_setoperatingmode(mode)
+#define SNTP_SET_SERVER_NAME(idx, name) sntp_setservername(idx, name)
+#define SNTP_INIT() sntp_init()
+#define SNTP_IS_ENABLED() sntp_enabled()
+#define SNTP_MODE_POLL SNTP_OPMODE_POLL
+#endif
+
+#define SNTP_SYNC_INTERVAL_MS (60 * 60 * 1000)
+
+static const char *TAG = "time_sync";
+static volatile bool s_synced = false;
+
+static void time_sync_notification(struct timeval *tv) {
+    char now[32];
+    struct tm local;
+    time_t seconds = tv->tv_sec;
+
+    localtime_r(&seconds, &local);
+    strftime(now, sizeof(now), "%Y-%m-%d %H:%M:%S", &local);
+    ESP_LOGI(TAG, "Clock synced: %s", now);
+    s_synced = true;
+}
+
+void time_sync_start(int utc_offset_hours) {
+    char tz[16];
+
+    // POSIX TZ counts the other way, UTC + 8 is "UTC-8"
+    snprintf(tz, sizeof(tz), "UTC%+d", -utc_offset_hours);
+    setenv("TZ", tz, 1);
+    tzset();
+
+    if (SNTP_IS_ENABLED()) {
+        return;
+    }
+
+    ESP_LOGI(TAG, "Syncing time from %s, timezone %s", CONFIG_WIFI_SNTP_SERVER, tz);
+    SNTP_SET_OPERATING_MODE(SNTP_MODE_POLL);
+    SNTP_SET_SERVER_NAME(0, CONFIG_WIFI_SNTP_SERVER);
+    sntp_set_time_sync_notification_cb(time_sync_notification);
+    sntp_set_sync_interval(SNTP_SYNC_INTERVAL_MS);
+    SNTP_INIT();
+}
+
+bool time_sync_is_synced(void) {
+    return s_synced;
+}
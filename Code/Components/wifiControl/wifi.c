@@ -1,9 +1,13 @@
+#include <string.h>
 #include "wifi.h"
 #include "hidden.h"
 #include "esp_wifi.h"
 #include "esp_event.h"
 #include "esp_log.h"
+#include "esp_netif.h"
+#include "esp_timer.h"
 #include "nvs_flash.h"
+#include "nvs.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/event_groups.h"
@@ -16,11 +20,110 @@ static EventGroupHandle_t s_wifi_event_group;
 #define WIFI_FAIL_BIT      BIT1
 #define WIFI_MAX_RETRY     3
 
+// Longest boot waits for an address, e.g. when the DHCP server never answers
+#define WIFI_CONNECT_TIMEOUT_MS 20000
+
+#define WIFI_CACHE_NAMESPACE "wifi_cache"
+#define WIFI_CACHE_KEY       "ap_lease"
+#define WIFI_CACHE_VERSION   3
+
+// Last good association, used to skip the scan on the next boot. The address is
+// not kept here: with CONFIG_LWIP_DHCP_RESTORE_LAST_IP the DHCP client asks for
+// the last lease straight away (no discover), the server confirms or refuses it,
+// and lwIP renews it as usual.
+typedef struct {
+    uint8_t version;
+    char ssid[33];
+    uint8_t bssid[6];
+    uint8_t channel;
+} wifi_cache_t;
+
+static wifi_config_t s_wifi_config;
+static wifi_cache_t s_cache;
+static bool s_warm_attempt = false;
+static int64_t s_start_time_us;
+static int64_t s_assoc_time_us;
+
+static bool wifi_cache_load(wifi_cache_t *cache) {
+    nvs_handle_t handle;
+    size_t size = sizeof(*cache);
+
+    if (nvs_open(WIFI_CACHE_NAMESPACE, NVS_READONLY, &handle) != ESP_OK) {
+        return false;
+    }
+    esp_err_t err = nvs_get_blob(handle, WIFI_CACHE_KEY, cache, &size);
+    nvs_close(handle);
+
+    // Ignore stale layouts and APs cached for a different network
+    return err == ESP_OK && size == sizeof(*cache) && cache->version == WIFI_CACHE_VERSION &&
+           strncmp(cache->ssid, WIFI_SSID, sizeof(cache->ssid)) == 0;
+}
+
+// Called from wifi_init_sta once connected, not from the event loop
+static void wifi_cache_store(void) {
+    wifi_ap_record_t ap_info;
+    nvs_handle_t handle;
+    wifi_cache_t cache = {0};
+
+    if (esp_wifi_sta_get_ap_info(&ap_info) != ESP_OK) {
+        ESP_LOGW(TAG, "Could not read AP info, AP not cached");
+        return;
+    }
+
+    cache.version = WIFI_CACHE_VERSION;
+    strncpy(cache.ssid, WIFI_SSID, sizeof(cache.ssid) - 1);
+    memcpy(cache.bssid, ap_info.bssid, sizeof(cache.bssid));
+    cache.channel = ap_info.primary;
+
+    // Skip the flash write when nothing changed since the last boot
+    if (memcmp(&cache, &s_cache, sizeof(cache)) == 0) {
+        return;
+    }
+
+    if (nvs_open(WIFI_CACHE_NAMESPACE, NVS_READWRITE, &handle) != ESP_OK) {
+        ESP_LOGW(TAG, "Could not open NVS, AP not cached");
+        return;
+    }
+    if (nvs_set_blob(handle, WIFI_CACHE_KEY, &cache, sizeof(cache)) == ESP_OK) {
+        nvs_commit(handle);
+        s_cache = cache;
+        ESP_LOGI(TAG, "Cached AP " MACSTR " on channel %d", MAC2STR(cache.bssid), cache.channel);
+    }
+    nvs_close(handle);
+}
+
+// Directed connect to the cached BSSID/channel, no scan
+static void wifi_apply_warm_config(void) {
+    s_wifi_config.sta.bssid_set = true;
+    memcpy(s_wifi_config.sta.bssid, s_cache.bssid, sizeof(s_cache.bssid));
+    s_wifi_config.sta.channel = s_cache.channel;
+
+    s_warm_attempt = true;
+}
+
+// Regular SSID scan
+static void wifi_apply_cold_config(void) {
+    s_wifi_config.sta.bssid_set = false;
+    memset(s_wifi_config.sta.bssid, 0, sizeof(s_wifi_config.sta.bssid));
+    s_wifi_config.sta.channel = 0;
+
+    s_warm_attempt = false;
+}
+
 void event_handler(void *arg, esp_event_base_t event_base, int32_t event_id, void *event_data) {
     if (event_base == WIFI_EVENT && event_id == WIFI_EVENT_STA_START) {
+        s_start_time_us = esp_timer_get_time();
         esp_wifi_connect();
         ESP_LOGI(TAG, "Attempting to connect to WiFi...");
     } else if (event_base == WIFI_EVENT && event_id == WIFI_EVENT_STA_DISCONNECTED) {
+        if (s_warm_attempt) {
+            // Cached AP or channel is gone, forget it and do a normal connect
+            ESP_LOGW(TAG, "Cached AP unreachable, falling back to a full scan");
+            wifi_apply_cold_config();
+            esp_wifi_set_config(ESP_IF_WIFI_STA, &s_wifi_config);
+            esp_wifi_connect();
+            return;
+        }
         if (s_retry_num < WIFI_MAX_RETRY) {
             esp_wifi_connect();
             s_retry_num++;
@@ -30,16 +133,25 @@ void event_handler(void *arg, esp_event_base_t event_base, int32_t event_id, voi
         }
         ESP_LOGW(TAG, "Connection to the AP failed.");
     } else if (event_base == WIFI_EVENT && event_id == WIFI_EVENT_STA_CONNECTED) {
-        ESP_LOGI(TAG, "Successfully connected to the AP.");
+        s_assoc_time_us = esp_timer_get_time();
+        ESP_LOGI(TAG, "Successfully connected to the AP in %lld ms.", (s_assoc_time_us - s_start_time_us) / 1000);
     } else if (event_base == IP_EVENT && event_id == IP_EVENT_STA_GOT_IP) {
         ip_event_got_ip_t *event = (ip_event_got_ip_t *)event_data;
+        int64_t now = esp_timer_get_time();
         ESP_LOGI(TAG, "Got IP: " IPSTR, IP2STR(&event->ip_info.ip));
+        ESP_LOGI(TAG, "%s boot: association-to-IP %lld ms, start-to-IP %lld ms",
+                 s_warm_attempt ? "Warm" : "Cold",
+                 (now - s_assoc_time_us) / 1000,
+                 (now - s_start_time_us) / 1000);
         s_retry_num = 0;
         xEventGroupSetBits(s_wifi_event_group, WIFI_CONNECTED_BIT);
     }
 }
 
 void wifi_init_sta(void) {
+    esp_event_handler_instance_t wifi_handler_instance;
+    esp_event_handler_instance_t ip_handler_instance;
+
     // Initialize NVS
     esp_err_t ret = nvs_flash_init();
     if (ret == ESP_ERR_NVS_NO_FREE_PAGES || ret == ESP_ERR_NVS_NEW_VERSION_FOUND) {
@@ -49,15 +161,16 @@ void wifi_init_sta(void) {
     ESP_ERROR_CHECK(ret);
 
     ESP_LOGI(TAG, "ESP32 WiFi Station");
-    
+
     s_wifi_event_group = xEventGroupCreate();
 
     ESP_ERROR_CHECK(esp_netif_init());
     ESP_ERROR_CHECK(esp_event_loop_create_default());
     esp_netif_create_default_wifi_sta();
 
-    ESP_ERROR_CHECK(esp_event_handler_instance_register(WIFI_EVENT, ESP_EVENT_ANY_ID, &event_handler, NULL, NULL));
-    ESP_ERROR_CHECK(esp_event_handler_instance_register(IP_EVENT, IP_EVENT_STA_GOT_IP, &event_handler, NULL, NULL));
+    // The handles are needed to unregister, the event group is gone once init returns
+    ESP_ERROR_CHECK(esp_event_handler_instance_register(WIFI_EVENT, ESP_EVENT_ANY_ID, &event_handler, NULL, &wifi_handler_instance));
+    ESP_ERROR_CHECK(esp_event_handler_instance_register(IP_EVENT, IP_EVENT_STA_GOT_IP, &event_handler, NULL, &ip_handler_instance));
 
     wifi_init_config_t cfg = WIFI_INIT_CONFIG_DEFAULT();
     ESP_ERROR_CHECK(esp_wifi_init(&cfg));
@@ -73,8 +186,18 @@ void wifi_init_sta(void) {
             },
         },
     };
+    s_wifi_config = wifi_config;
+
+    if (wifi_cache_load(&s_cache)) {
+        ESP_LOGI(TAG, "Trying cached AP " MACSTR " on channel %d", MAC2STR(s_cache.bssid), s_cache.channel);
+        wifi_apply_warm_config();
+    } else {
+        memset(&s_cache, 0, sizeof(s_cache));
+        wifi_apply_cold_config();
+    }
+
     ESP_ERROR_CHECK(esp_wifi_set_mode(WIFI_MODE_STA));
-    ESP_ERROR_CHECK(esp_wifi_set_config(ESP_IF_WIFI_STA, &wifi_config));
+    ESP_ERROR_CHECK(esp_wifi_set_config(ESP_IF_WIFI_STA, &s_wifi_config));
     ESP_ERROR_CHECK(esp_wifi_start());
 
     ESP_LOGI(TAG, "WiFi initialization complete.");
@@ -83,17 +206,32 @@ void wifi_init_sta(void) {
                                            WIFI_CONNECTED_BIT | WIFI_FAIL_BIT,
                                            pdFALSE,
                                            pdFALSE,
-                                           portMAX_DELAY);
+                                           pdMS_TO_TICKS(WIFI_CONNECT_TIMEOUT_MS));
+
+    if (!(bits & (WIFI_CONNECTED_BIT | WIFI_FAIL_BIT))) {
+        // Associated or not, no address came, boot goes on offline
+        ESP_LOGW(TAG, "No IP after %d ms", WIFI_CONNECT_TIMEOUT_MS);
+        bits = xEventGroupSetBits(s_wifi_event_group, WIFI_FAIL_BIT);
+    }
 
     if (bits & WIFI_CONNECTED_BIT) {
         ESP_LOGI(TAG, "Connected to AP, SSID: %s", wifi_config.sta.ssid);
+        wifi_cache_store();
     } else if (bits & WIFI_FAIL_BIT) {
         ESP_LOGE(TAG, "Failed to connect to SSID: %s", wifi_config.sta.ssid);
     } else {
         ESP_LOGE(TAG, "Unexpected event during WiFi connection");
     }
 
-    ESP_ERROR_CHECK(esp_event_handler_instance_unregister(IP_EVENT, IP_EVENT_STA_GOT_IP, &event_handler));
-    ESP_ERROR_CHECK(esp_event_handler_instance_unregister(WIFI_EVENT, ESP_EVENT_ANY_ID, &event_handler));
+    ESP_ERROR_CHECK(esp_event_handler_instance_unregister(IP_EVENT, IP_EVENT_STA_GOT_IP, ip_handler_instance));
+    ESP_ERROR_CHECK(esp_event_handler_instance_unregister(WIFI_EVENT, ESP_EVENT_ANY_ID, wifi_handler_instance));
     vEventGroupDelete(s_wifi_event_group);
+    s_wifi_event_group = NULL;
+}
+
+bool wifi_is_connected(void) {
+    wifi_ap_record_t ap_info;
+
+    // The event group is gone after init, ask the driver instead
+    return esp_wifi_sta_get_ap_info(&ap_info) == ESP_OK;
 }
@@ -0,0 +1,122 @@
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_random.h"
+#include "wordDictionary.h"
+#include "dictionaryBench.h"
+
+/*-----------------------------------------------------------
+Literal Constants
+------------------------------------------------------------*/
+
+#define LOG_TAG "DictionaryBench"
+
+#define QUERY_COUNT     1024
+#define ROUNDS          20
+#define FP_SAMPLE_COUNT 100000
+
+/*-----------------------------------------------------------
+Statics
+------------------------------------------------------------*/
+
+static char hits[QUERY_COUNT][DICTIONARY_WORD_LENGTH + 1];
+static char typos[QUERY_COUNT][DICTIONARY_WORD_LENGTH + 1];
+
+/*-----------------------------------------------------------
+Local Function Prototypes
+------------------------------------------------------------*/
+
+/*
+* Description:
+*      Times ROUNDS passes over the queries and logs the time per lookup
+*
+* Arguments:
+*     const char *label: Name of the case for the log
+*     char queries[][]: The words to look up
+*
+* Returns:
+*      None
+*/
+static void runLookups(const char *label, char queries[][DICTIONARY_WORD_LENGTH + 1]);
+
+/*-----------------------------------------------------------
+Functions
+------------------------------------------------------------*/
+
+static void runLookups(const char *label, char queries[][DICTIONARY_WORD_LENGTH + 1])
+{
+    uint32_t found = 0;
+    int64_t start = esp_timer_get_time();
+
+    for(uint8_t round = 0; round < ROUNDS; round++)
+    {
+        for(uint16_t query = 0; query < QUERY_COUNT; query++)
+        {
+            found += wordDictionaryContains(queries[query]);
+        }
+    }
+
+    int64_t elapsed = esp_timer_get_time() - start;
+
+    ESP_LOGI(LOG_TAG, "%-6s %5lld ns/lookup, %lu%% found", label,
+             elapsed * 1000 / (ROUNDS * QUERY_COUNT), (unsigned long)(found * 100 / (ROUNDS * QUERY_COUNT)));
+}
+
+void wordDictionaryBench(void)
+{
+    uint32_t size = wordDictionarySize();
+
+    if(size == 0)
+    {
+        ESP_LOGW(LOG_TAG, "No dictionary loaded");
+        return;
+    }
+
+    // Words from the list, and the same kind of words with one letter changed
+    for(uint16_t query = 0; query < QUERY_COUNT; query++)
+    {
+        wordDictionaryUnpack(wordDictionaryGet(esp_random() % size), hits[query]);
+        wordDictionaryUnpack(wordDictionaryGet(esp_random() % size), typos[query]);
+        typos[query][esp_random() % DICTIONARY_WORD_LENGTH] = 'a' + esp_random() % 26;
+    }
+
+    ESP_LOGI(LOG_TAG, "%lu words, %d lookups per case", (unsigned long)size, ROUNDS * QUERY_COUNT);
+
+    wordDictionarySetIndexEnabled(false);
+    wordDictionarySetBloomEnabled(false);
+    ESP_LOGI(LOG_TAG, "Binary search");
+    runLookups("words", hits);
+    runLookups("typos", typos);
+
+    wordDictionarySetIndexEnabled(true);
+    ESP_LOGI(LOG_TAG, "First-two-letter index");
+    runLookups("words", hits);
+    runLookups("typos", typos);
+
+    wordDictionarySetBloomEnabled(true);
+    ESP_LOGI(LOG_TAG, "Bloom filter + index");
+    runLookups("words", hits);
+    runLookups("typos", typos);
+
+    // False positives: random letter strings that are not words but pass the filter
+    uint32_t nonWords = 0;
+    uint32_t passed = 0;
+    char word[DICTIONARY_WORD_LENGTH + 1] = {0};
+
+    wordDictionarySetBloomEnabled(false);
+    for(uint32_t sample = 0; sample < FP_SAMPLE_COUNT; sample++)
+    {
+        for(uint8_t pos = 0; pos < DICTIONARY_WORD_LENGTH; pos++)
+        {
+            word[pos] = 'a' + esp_random() % 26;
+        }
+
+        if(!wordDictionaryContains(word))
+        {
+            nonWords++;
+            passed += wordDictionaryMayContain(word);
+        }
+    }
+    wordDictionarySetBloomEnabled(true);
+
+    ESP_LOGI(LOG_TAG, "Bloom false positives: %lu of %lu non-words", (unsigned long)passed, (unsigned long)nonWords);
+}
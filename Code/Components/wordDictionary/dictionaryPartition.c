@@ -0,0 +1,72 @@
+#include "esp_log.h"
+#include "esp_idf_version.h"
+#include "esp_partition.h"
+#include "dictionaryFormat.h"
+#include "wordDictionary.h"
+#include "dictionaryPartition.h"
+
+/*-----------------------------------------------------------
+Literal Constants
+------------------------------------------------------------*/
+
+#define LOG_TAG "WordDictionary"
+
+// The mmap types were renamed when the partition API moved out of spi_flash
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 1, 0)
+#define DICTIONARY_MMAP_DATA ESP_PARTITION_MMAP_DATA
+typedef esp_partition_mmap_handle_t dictionaryMmapHandle_t;
+#else
+#define DICTIONARY_MMAP_DATA SPI_FLASH_MMAP_DATA
+typedef spi_flash_mmap_handle_t dictionaryMmapHandle_t;
+#endif
+
+/*-----------------------------------------------------------
+Statics
+------------------------------------------------------------*/
+
+static dictionaryMmapHandle_t mmapHandle;
+
+/*-----------------------------------------------------------
+Functions
+------------------------------------------------------------*/
+
+esp_err_t initWordDictionary(void)
+{
+    const esp_partition_t *partition;
+    dictionaryHeader_t header;
+    const void *image;
+    esp_err_t ret;
+
+    partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, DICTIONARY_PARTITION_LABEL);
+    if(partition == NULL)
+    {
+        ESP_LOGW(LOG_TAG, "No \"%s\" partition, guesses will not be checked", DICTIONARY_PARTITION_LABEL);
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    // Read the header first so only the part of the partition in use gets mapped
+    ret = esp_partition_read(partition, 0, &header, sizeof(header));
+    if(ret != ESP_OK || header.magic != DICTIONARY_MAGIC || header.imageSize > partition->size)
+    {
+        ESP_LOGW(LOG_TAG, "No dictionary image in the \"%s\" partition, was it flashed?", DICTIONARY_PARTITION_LABEL);
+        return ESP_ERR_INVALID_VERSION;
+    }
+
+    ret = esp_partition_mmap(partition, 0, header.imageSize, DICTIONARY_MMAP_DATA, &image, &mmapHandle);
+    if(ret != ESP_OK)
+    {
+        ESP_LOGE(LOG_TAG, "Failed to map the dictionary (%s)", esp_err_to_name(ret));
+        return ret;
+    }
+
+    if(!wordDictionaryAttach(image, header.imageSize))
+    {
+        ESP_LOGE(LOG_TAG, "Dictionary header invalid (version %u, expected %u)", header.version, DICTIONARY_FORMAT_VERSION);
+        esp_partition_munmap(mmapHandle);
+        return ESP_ERR_INVALID_VERSION;
+    }
+
+    ESP_LOGI(LOG_TAG, "Dictionary mapped, %lu words", (unsigned long)wordDictionarySize());
+
+    return ESP_OK;
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+/*-----------------------------------------------------------
+Function Prototypes
+------------------------------------------------------------*/
+
+/*
+* Description:
+*      Times dictionary lookups with and without the first-two-letter index
+*      and the bloom filter, for words in the list and for typos, measures the
+*      filter's false positive rate and logs the results
+*      The dictionary has to be initialized first
+*
+* Arguments:
+*     None
+*
+* Returns:
+*      None
+*/
+void wordDictionaryBench(void);
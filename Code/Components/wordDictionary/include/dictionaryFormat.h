@@ -0,0 +1,96 @@
+#pragma once
+
+#include <assert.h>
+#include <stdint.h>
+
+/*-----------------------------------------------------------
+Literal Constants
+------------------------------------------------------------*/
+
+// Layout of the dictionary image stored in the "dict" partition
+// Written by tools/gen_dictionary.py, all fields little endian
+//
+//  +--------------------+  0
+//  | dictionaryHeader_t |
+//  +--------------------+  wordsOffset
+//  | packed words       |  wordCount x uint32_t, sorted ascending
+//  +--------------------+  answersOffset (0 if there are no answers)
+//  | packed answers     |  answerCount x uint32_t, sorted ascending
+//  +--------------------+  indexOffset (0 if there is no index)
+//  | index              |  indexSize bytes
+//  +--------------------+  bloomOffset (0 if there is no filter)
+//  | bloom filter       |  bloomSize bytes, 64 byte blocks
+//  +--------------------+  imageSize
+//
+// The index splits the words into buckets by their first two letters. Entry
+// (first * 26 + second) is the position of the bucket's first word, the
+// extra last entry is wordCount, so a bucket ends where the next one starts
+//
+// The bloom filter is blocked: one hash of the packed word picks a 64 byte
+// block (one cache line) and is split into bloomProbes bit positions inside
+// it, so a lookup touches a single line. See dictionaryBloomHash
+
+#define DICTIONARY_MAGIC            0x43494457  // "WDIC"
+#define DICTIONARY_FORMAT_VERSION   3
+
+#define DICTIONARY_PARTITION_LABEL  "dict"
+
+#define DICTIONARY_INDEX_BUCKETS    (26 * 26)
+#define DICTIONARY_INDEX_SIZE       ((DICTIONARY_INDEX_BUCKETS + 1) * sizeof(uint16_t))
+
+#define DICTIONARY_BLOOM_BLOCK_SIZE 64
+#define DICTIONARY_BLOOM_BLOCK_BITS (DICTIONARY_BLOOM_BLOCK_SIZE * 8)
+#define DICTIONARY_BLOOM_MAX_PROBES 16
+
+/*-----------------------------------------------------------
+Types
+------------------------------------------------------------*/
+
+typedef struct
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t headerSize;    // sizeof(dictionaryHeader_t) for this version
+    uint32_t imageSize;     // Header and every section
+    uint32_t wordCount;
+    uint32_t wordsOffset;
+    uint32_t indexOffset;
+    uint32_t indexSize;
+    uint32_t bloomOffset;
+    uint32_t bloomSize;     // Multiple of DICTIONARY_BLOOM_BLOCK_SIZE
+    uint32_t bloomProbes;   // Bits set per word
+    uint32_t answersOffset;
+    uint32_t answerCount;   // Words the offline daily word is picked from, all of them are also in words
+    uint32_t headerCrc;     // CRC-32 of the header up to this field
+} dictionaryHeader_t;
+
+static_assert(sizeof(dictionaryHeader_t) == 52, "Dictionary header layout changed");
+
+/*-----------------------------------------------------------
+Functions
+------------------------------------------------------------*/
+
+/*
+* Description:
+*      Hashes a packed word for the bloom filter (MurmurHash3 fmix64),
+*      gen_dictionary.py uses the same hash
+*      The high half picks the block, the low half is split into the probes
+*
+* Arguments:
+*     uint32_t packed: The packed word
+*
+* Returns:
+*      uint64_t: The hash
+*/
+static inline uint64_t dictionaryBloomHash(uint32_t packed)
+{
+    uint64_t hash = packed;
+
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+
+    return hash;
+}
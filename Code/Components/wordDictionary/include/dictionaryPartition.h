@@ -0,0 +1,23 @@
+#pragma once
+
+#include "esp_err.h"
+
+/*-----------------------------------------------------------
+Function Prototypes
+------------------------------------------------------------*/
+
+/*
+* Description:
+*      Maps the "dict" flash partition and attaches it to the word dictionary
+*      Lookups read the partition through the flash cache, nothing is copied
+*      to RAM. Boot only pays for reading and checking the image header
+*
+* Arguments:
+*     None
+*
+* Returns:
+*      esp_err_t: ESP_OK if the dictionary is ready
+*                 ESP_ERR_NOT_FOUND if there is no "dict" partition
+*                 ESP_ERR_INVALID_VERSION if the image is missing or invalid
+*/
+esp_err_t initWordDictionary(void);
@@ -0,0 +1,184 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*-----------------------------------------------------------
+Literal Constants
+------------------------------------------------------------*/
+
+#define DICTIONARY_WORD_LENGTH      5
+#define DICTIONARY_BITS_PER_LETTER  5
+
+// Returned by wordDictionaryPack for anything that is not five letters
+#define DICTIONARY_INVALID_WORD     UINT32_MAX
+
+/*-----------------------------------------------------------
+Function Prototypes
+------------------------------------------------------------*/
+
+/*
+* Description:
+*      Validates a dictionary image and uses it for lookups
+*      Only the header is checked, the words are used in place (no copy)
+*
+* Arguments:
+*     const void *image: The image (see dictionaryFormat.h), 4 byte aligned
+*     uint32_t imageSize: Bytes available at image
+*
+* Returns:
+*      True if the image is valid and was attached
+*      False otherwise, the dictionary is left empty
+*/
+bool wordDictionaryAttach(const void *image, uint32_t imageSize);
+
+
+/*
+* Description:
+*      Checks if a dictionary is attached
+*
+* Arguments:
+*     None
+*
+* Returns:
+*      True if lookups use a word list
+*      False if no valid dictionary was found
+*/
+bool wordDictionaryIsLoaded(void);
+
+
+/*
+* Description:
+*      Packs a word into 25 bits, five letters of 5 bits each with the first
+*      letter in the highest bits. Packed words sort in alphabetical order
+*
+* Arguments:
+*     const char *word: The word to pack (DICTIONARY_WORD_LENGTH letters, any case)
+*
+* Returns:
+*      uint32_t: The packed word, DICTIONARY_INVALID_WORD if it is not made of letters
+*/
+uint32_t wordDictionaryPack(const char *word);
+
+
+/*
+* Description:
+*      Checks if the word is a valid guess
+*
+* Arguments:
+*     const char *word: The word to look up (DICTIONARY_WORD_LENGTH letters, any case)
+*
+* Returns:
+*      True if the word is in the dictionary
+*      False otherwise, or if no dictionary is attached
+*/
+bool wordDictionaryContains(const char *word);
+
+
+/*
+* Description:
+*      Gets the number of answers, the words a daily word can be picked from
+*
+* Arguments:
+*     None
+*
+* Returns:
+*      uint32_t: The number of answers, 0 if the image has none
+*/
+uint32_t wordDictionaryAnswerCount(void);
+
+
+/*
+* Description:
+*      Gets an answer by its position in the answer list (alphabetical order)
+*
+* Arguments:
+*     uint32_t position: The position, 0 to wordDictionaryAnswerCount() - 1
+*
+* Returns:
+*      uint32_t: The packed answer, DICTIONARY_INVALID_WORD if the position is out of range
+*/
+uint32_t wordDictionaryGetAnswer(uint32_t position);
+
+
+/*
+* Description:
+*      Checks the word against the bloom filter only
+*      Used by the benchmarks to measure the filter's false positive rate
+*
+* Arguments:
+*     const char *word: The word to check (DICTIONARY_WORD_LENGTH letters, any case)
+*
+* Returns:
+*      True if the word may be in the dictionary (always, if the image has no filter)
+*      False if it is definitely not
+*/
+bool wordDictionaryMayContain(const char *word);
+
+
+/*
+* Description:
+*      Unpacks a word packed by wordDictionaryPack
+*
+* Arguments:
+*     uint32_t packed: The packed word
+*     char *word: Buffer for the word (DICTIONARY_WORD_LENGTH + 1 chars, lowercase, null terminated)
+*
+* Returns:
+*      None
+*/
+void wordDictionaryUnpack(uint32_t packed, char *word);
+
+
+/*
+* Description:
+*      Gets a word by its position in the dictionary (alphabetical order)
+*
+* Arguments:
+*     uint32_t position: The position, 0 to wordDictionarySize() - 1
+*
+* Returns:
+*      uint32_t: The packed word, DICTIONARY_INVALID_WORD if the position is out of range
+*/
+uint32_t wordDictionaryGet(uint32_t position);
+
+
+/*
+* Description:
+*      Turns the first-two-letter index on or off, to compare it against a
+*      plain binary search in the benchmarks. On by default when the image has one
+*
+* Arguments:
+*     bool enabled: True to use the index
+*
+* Returns:
+*      None
+*/
+void wordDictionarySetIndexEnabled(bool enabled);
+
+
+/*
+* Description:
+*      Turns the bloom filter in front of the exact lookup on or off, to
+*      measure it in the benchmarks. On by default when the image has one
+*
+* Arguments:
+*     bool enabled: True to use the filter
+*
+* Returns:
+*      None
+*/
+void wordDictionarySetBloomEnabled(bool enabled);
+
+
+/*
+* Description:
+*      Gets the number of words in the dictionary
+*
+* Arguments:
+*     None
+*
+* Returns:
+*      uint32_t: The number of words, 0 if no dictionary is attached
+*/
+uint32_t wordDictionarySize(void);
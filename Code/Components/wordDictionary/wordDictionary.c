@@ -0,0 +1,366 @@
+#include <stddef.h>
+#include <string.h>
+#include "dictionaryFormat.h"
+#include "wordDictionary.h"
+
+/*-----------------------------------------------------------
+Literal Constants
+------------------------------------------------------------*/
+
+#define LETTER_COUNT 26
+
+#define CRC32_POLY 0xEDB88320  // Reflected CRC-32, same as zlib.crc32
+
+/*-----------------------------------------------------------
+Macros
+------------------------------------------------------------*/
+
+// Maps 'a'-'z' and 'A'-'Z' to 0 - 25, anything else to >= LETTER_COUNT
+#define LETTER_INDEX(c) ((uint8_t)(((c) | 0x20) - 'a'))
+
+/*-----------------------------------------------------------
+Statics
+------------------------------------------------------------*/
+
+static const uint32_t *dictionaryWords = NULL;
+static uint32_t dictionaryWordCount = 0;
+static const uint32_t *dictionaryAnswers = NULL;
+static uint32_t dictionaryAnswerCount = 0;
+static const uint16_t *dictionaryIndex = NULL;  // NULL when the image has no index
+static const uint32_t *bloomFilter = NULL;      // NULL when the image has no filter
+static uint32_t bloomBlockCount = 0;
+static uint32_t bloomProbes = 0;
+static bool isIndexEnabled = true;
+static bool isBloomEnabled = true;
+
+/*-----------------------------------------------------------
+Local Function Prototypes
+------------------------------------------------------------*/
+
+/*
+* Description:
+*      Computes the CRC-32 of a buffer
+*      Bitwise, it only ever runs over the header
+*
+* Arguments:
+*     const uint8_t *data: The data
+*     size_t size: The number of bytes
+*
+* Returns:
+*      uint32_t: The CRC
+*/
+static uint32_t crc32(const uint8_t *data, size_t size);
+
+
+/*
+* Description:
+*      Checks the packed word against the bloom filter
+*
+* Arguments:
+*     uint32_t packed: The packed word
+*
+* Returns:
+*      True if the word may be in the dictionary
+*      False if it is definitely not
+*/
+static bool bloomMayContain(uint32_t packed);
+
+
+/*
+* Description:
+*      Checks that every entry of the index is usable as a range of the words
+*      A bad one would send the search outside the word table
+*
+* Arguments:
+*     const uint16_t *index: The index, DICTIONARY_INDEX_BUCKETS + 1 entries
+*     uint32_t wordCount: The number of words
+*
+* Returns:
+*      True if the entries start at 0, never go down and end at wordCount
+*      False otherwise
+*/
+static bool isIndexValid(const uint16_t *index, uint32_t wordCount);
+
+/*-----------------------------------------------------------
+Functions
+------------------------------------------------------------*/
+
+static uint32_t crc32(const uint8_t *data, size_t size)
+{
+    uint32_t crc = 0xFFFFFFFF;
+
+    for(size_t i = 0; i < size; i++)
+    {
+        crc ^= data[i];
+
+        for(uint8_t bit = 0; bit < 8; bit++)
+        {
+            crc = (crc >> 1) ^ (CRC32_POLY & (0 - (crc & 1)));
+        }
+    }
+
+    return ~crc;
+}
+
+static bool bloomMayContain(uint32_t packed)
+{
+    uint64_t hash = dictionaryBloomHash(packed);
+    uint32_t low = (uint32_t)hash;
+    const uint32_t *block;
+    uint32_t first;
+    uint32_t step;
+    uint32_t bit;
+
+    // High half picks the block (multiply-shift instead of a modulo)
+    block = &bloomFilter[(((hash >> 32) * bloomBlockCount) >> 32) * (DICTIONARY_BLOOM_BLOCK_SIZE / sizeof(uint32_t))];
+
+    // Low half becomes the probes inside the block, first + i * step
+    first = low % DICTIONARY_BLOOM_BLOCK_BITS;
+    step = ((low / DICTIONARY_BLOOM_BLOCK_BITS) % DICTIONARY_BLOOM_BLOCK_BITS) | 1;
+
+    // Most non-words miss on the first probe or two, so stop at the first clear bit
+    for(uint32_t probe = 0; probe < bloomProbes; probe++)
+    {
+        bit = (first + probe * step) % DICTIONARY_BLOOM_BLOCK_BITS;
+
+        if(!((block[bit / 32] >> (bit % 32)) & 1))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool isIndexValid(const uint16_t *index, uint32_t wordCount)
+{
+    if(index[0] != 0 || index[DICTIONARY_INDEX_BUCKETS] != wordCount)
+    {
+        return false;
+    }
+
+    for(uint32_t bucket = 0; bucket < DICTIONARY_INDEX_BUCKETS; bucket++)
+    {
+        if(index[bucket] > index[bucket + 1])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool wordDictionaryAttach(const void *image, uint32_t imageSize)
+{
+    dictionaryHeader_t header;
+
+    dictionaryWords = NULL;
+    dictionaryWordCount = 0;
+    dictionaryAnswers = NULL;
+    dictionaryAnswerCount = 0;
+    dictionaryIndex = NULL;
+    bloomFilter = NULL;
+
+    if(image == NULL || imageSize < sizeof(header))
+    {
+        return false;
+    }
+
+    memcpy(&header, image, sizeof(header));
+
+    if(header.magic != DICTIONARY_MAGIC ||
+       header.version != DICTIONARY_FORMAT_VERSION ||
+       header.headerSize != sizeof(header) ||
+       header.headerCrc != crc32((const uint8_t *)&header, offsetof(dictionaryHeader_t, headerCrc)))
+    {
+        return false;
+    }
+
+    // Every section has to lie inside the image, and the image inside what is mapped
+    if(header.imageSize > imageSize ||
+       header.wordsOffset % sizeof(uint32_t) != 0 ||
+       header.wordsOffset < sizeof(header) ||
+       header.wordCount > (header.imageSize - header.wordsOffset) / sizeof(uint32_t) ||
+       (header.answersOffset != 0 && (header.answersOffset % sizeof(uint32_t) != 0 ||
+                                      header.answersOffset > header.imageSize ||
+                                      header.answerCount > (header.imageSize - header.answersOffset) / sizeof(uint32_t))) ||
+       (header.indexOffset != 0 && (header.indexOffset > header.imageSize ||
+                                    header.indexSize > header.imageSize - header.indexOffset)) ||
+       (header.bloomOffset != 0 && (header.bloomOffset > header.imageSize ||
+                                    header.bloomSize > header.imageSize - header.bloomOffset)))
+    {
+        return false;
+    }
+
+    dictionaryWords = (const uint32_t *)((const uint8_t *)image + header.wordsOffset);
+    dictionaryWordCount = header.wordCount;
+
+    if(header.answersOffset != 0)
+    {
+        dictionaryAnswers = (const uint32_t *)((const uint8_t *)image + header.answersOffset);
+        dictionaryAnswerCount = header.answerCount;
+    }
+
+    // The index is optional, fall back to searching every word if it doesn't fit this image
+    if(header.indexOffset != 0 && header.indexSize == DICTIONARY_INDEX_SIZE && header.indexOffset % sizeof(uint16_t) == 0)
+    {
+        dictionaryIndex = (const uint16_t *)((const uint8_t *)image + header.indexOffset);
+
+        // Checked once here so the lookups can trust every entry
+        if(!isIndexValid(dictionaryIndex, header.wordCount))
+        {
+            dictionaryIndex = NULL;
+        }
+    }
+
+    // The filter is optional too
+    if(header.bloomOffset != 0 && header.bloomOffset % sizeof(uint32_t) == 0 &&
+       header.bloomSize >= DICTIONARY_BLOOM_BLOCK_SIZE && header.bloomSize % DICTIONARY_BLOOM_BLOCK_SIZE == 0 &&
+       header.bloomProbes > 0 && header.bloomProbes <= DICTIONARY_BLOOM_MAX_PROBES)
+    {
+        bloomFilter = (const uint32_t *)((const uint8_t *)image + header.bloomOffset);
+        bloomBlockCount = header.bloomSize / DICTIONARY_BLOOM_BLOCK_SIZE;
+        bloomProbes = header.bloomProbes;
+    }
+
+    return true;
+}
+
+bool wordDictionaryIsLoaded(void)
+{
+    return dictionaryWords != NULL;
+}
+
+uint32_t wordDictionaryPack(const char *word)
+{
+    uint32_t packed = 0;
+    uint8_t letter;
+
+    if(word == NULL)
+    {
+        return DICTIONARY_INVALID_WORD;
+    }
+
+    for(uint8_t pos = 0; pos < DICTIONARY_WORD_LENGTH; pos++)
+    {
+        letter = LETTER_INDEX(word[pos]);
+
+        if(letter >= LETTER_COUNT)
+        {
+            return DICTIONARY_INVALID_WORD;
+        }
+
+        packed = (packed << DICTIONARY_BITS_PER_LETTER) | letter;
+    }
+
+    return packed;
+}
+
+bool wordDictionaryContains(const char *word)
+{
+    uint32_t key = wordDictionaryPack(word);
+    const uint32_t *base = dictionaryWords;
+    uint32_t count = dictionaryWordCount;
+    uint32_t half;
+    uint32_t bucket;
+
+    if(key == DICTIONARY_INVALID_WORD || count == 0)
+    {
+        return false;
+    }
+
+    // Most non-words (typos) stop here after touching one cache line
+    if(bloomFilter != NULL && isBloomEnabled && !bloomMayContain(key))
+    {
+        return false;
+    }
+
+    // Jump to the words sharing the first two letters, a few dozen at most
+    if(dictionaryIndex != NULL && isIndexEnabled)
+    {
+        bucket = (key >> (3 * DICTIONARY_BITS_PER_LETTER)) & 0x3FF;
+        bucket = (bucket >> DICTIONARY_BITS_PER_LETTER) * LETTER_COUNT + (bucket & 0x1F);
+
+        base = &dictionaryWords[dictionaryIndex[bucket]];
+        count = dictionaryIndex[bucket + 1] - dictionaryIndex[bucket];
+
+        if(count == 0)
+        {
+            return false;
+        }
+    }
+
+    // Branch-light binary search, the loop runs a fixed log2(n) times and the
+    // compare only picks which half to keep (compiles to a conditional move)
+    while(count > 1)
+    {
+        half = count / 2;
+        base = (base[half] <= key) ? &base[half] : base;
+        count -= half;
+    }
+
+    return *base == key;
+}
+
+void wordDictionaryUnpack(uint32_t packed, char *word)
+{
+    for(int8_t pos = DICTIONARY_WORD_LENGTH - 1; pos >= 0; pos--)
+    {
+        word[pos] = 'a' + (packed & 0x1F);
+        packed >>= DICTIONARY_BITS_PER_LETTER;
+    }
+
+    word[DICTIONARY_WORD_LENGTH] = '\0';
+}
+
+uint32_t wordDictionaryGet(uint32_t position)
+{
+    if(position >= dictionaryWordCount)
+    {
+        return DICTIONARY_INVALID_WORD;
+    }
+
+    return dictionaryWords[position];
+}
+
+bool wordDictionaryMayContain(const char *word)
+{
+    uint32_t key = wordDictionaryPack(word);
+
+    if(key == DICTIONARY_INVALID_WORD || dictionaryWords == NULL)
+    {
+        return false;
+    }
+
+    return bloomFilter == NULL || bloomMayContain(key);
+}
+
+uint32_t wordDictionaryAnswerCount(void)
+{
+    return dictionaryAnswerCount;
+}
+
+uint32_t wordDictionaryGetAnswer(uint32_t position)
+{
+    if(position >= dictionaryAnswerCount)
+    {
+        return DICTIONARY_INVALID_WORD;
+    }
+
+    return dictionaryAnswers[position];
+}
+
+void wordDictionarySetIndexEnabled(bool enabled)
+{
+    isIndexEnabled = enabled;
+}
+
+void wordDictionarySetBloomEnabled(bool enabled)
+{
+    isBloomEnabled = enabled;
+}
+
+uint32_t wordDictionarySize(void)
+{
+    return dictionaryWordCount;
+}
@@ -0,0 +1,549 @@
+#include "esp_log.h"
+#include "esp_timer.h"
+#include <string.h>
+#include <time.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "nvs.h"
+#include "api_client.h"
+#include "api_request.h"
+#include "wordDictionary.h"
+#include "guessEvaluator.h"
+#include "dailyWord.h"
+
+/*-----------------------------------------------------------
+Literal Constants
+------------------------------------------------------------*/
+
+#define LOG_TAG "DailyWord"
+
+#define NVS_NAMESPACE   "daily_word"
+#define NVS_KEY_DATE    "date"
+#define NVS_KEY_WORD    "word"
+
+#define WORD_SIZE 6 // 5 characters + null terminator
+
+// The api rolls the word over at midnight in this timezone (set in menuconfig)
+#define API_UTC_OFFSET_HOURS CONFIG_API_UTC_OFFSET_HOURS
+
+#define SECONDS_PER_DAY 86400
+
+// Tomorrow's word is requested this long before midnight, and given up on
+// this long before midnight if it has not arrived
+#define ROLLOVER_PREFETCH_LEAD_S    (5 * 60)
+#define ROLLOVER_COLLECT_LEAD_S     30
+
+// The api only knows tomorrow's word close to midnight
+static_assert(ROLLOVER_PREFETCH_LEAD_S <= API_NEXT_WORD_WINDOW_S, "Tomorrow's word is requested before the api has it");
+
+// How often to check again while the clock is not set
+#define ROLLOVER_CLOCK_RETRY_S      60
+
+// Anything before this means the clock was never set
+#define MIN_VALID_YEAR 2024
+
+// Offline pick: answer = (day * OFFLINE_STEP + OFFLINE_OFFSET) mod answerCount
+// The step is nudged until it is coprime with the answer count, so no word
+// repeats until every answer has been used once
+#define OFFLINE_STEP    7919
+#define OFFLINE_OFFSET  1013
+
+/*-----------------------------------------------------------
+Enums
+------------------------------------------------------------*/
+
+typedef enum
+{
+    ROLLOVER_WAIT,      // Next run works out when to prefetch
+    ROLLOVER_PREFETCH,  // Next run requests tomorrow's word
+    ROLLOVER_COLLECT,   // Next run takes the word once it has arrived
+    ROLLOVER_SWAP       // Next run (just past midnight) makes it the cached word
+} rolloverPhase_t;
+
+/*-----------------------------------------------------------
+Statics
+------------------------------------------------------------*/
+
+// Written by the game and by the rollover timer at midnight
+static uint32_t cachedDate = 0;
+static char cachedWord[WORD_SIZE];
+static portMUX_TYPE cacheLock = portMUX_INITIALIZER_UNLOCKED;
+
+// Tomorrow's word, only touched by the rollover timer
+static uint32_t nextDate = 0;
+static char nextWord[WORD_SIZE];
+
+static esp_timer_handle_t rolloverTimer = NULL;
+static rolloverPhase_t rolloverPhase = ROLLOVER_WAIT;
+static uint32_t rolloverDate = 0;   // Date that starts at the coming midnight
+static api_request_handle_t nextWordRequest = NULL;
+
+/*-----------------------------------------------------------
+Local Function Prototypes
+------------------------------------------------------------*/
+
+/*
+* Description:
+*      Gets the current date in the api's timezone as YYYYMMDD
+* 
+* Arguments:
+*     uint32_t *dateKey: Where to store the date
+* 
+* Returns:
+*      True if the clock is set and the date is valid
+*      False if the date is not known
+*/
+static bool getDateKey(uint32_t *dateKey);
+
+
+/*
+* Description:
+*      Gets the time left until midnight in the api's timezone
+* 
+* Arguments:
+*     uint32_t *dateKey: Where to store the date that starts at midnight (YYYYMMDD)
+* 
+* Returns:
+*      int32_t: Seconds until midnight, -1 if the clock is not set
+*/
+static int32_t secondsToMidnight(uint32_t *dateKey);
+
+
+/*
+* Description:
+*      Starts the rollover timer for the next phase
+* 
+* Arguments:
+*     rolloverPhase_t phase: The phase to run when the timer fires
+*     int32_t delaySeconds: Seconds until it fires
+* 
+* Returns:
+*      None
+*/
+static void armRollover(rolloverPhase_t phase, int32_t delaySeconds);
+
+
+/*
+* Description:
+*      Rollover timer callback, runs the current phase and arms the next one
+*      Never waits on the api, the request runs on the api worker
+* 
+* Arguments:
+*     void *arg: Unused
+* 
+* Returns:
+*      None
+*/
+static void rolloverCallback(void *arg);
+
+
+/*
+* Description:
+*      Converts a YYYYMMDD date to days since 1970-01-01
+* 
+* Arguments:
+*     uint32_t dateKey: The date
+* 
+* Returns:
+*      uint32_t: The day number
+*/
+static uint32_t dateKeyToDay(uint32_t dateKey);
+
+
+/*
+* Description:
+*      Computes the greatest common divisor of two numbers
+* 
+* Arguments:
+*     uint32_t a: The first number
+*     uint32_t b: The second number
+* 
+* Returns:
+*      uint32_t: The greatest common divisor
+*/
+static uint32_t gcd(uint32_t a, uint32_t b);
+
+
+/*
+* Description:
+*      Loads the cached word and its date from NVS into RAM
+* 
+* Arguments:
+*     None
+* 
+* Returns:
+*      None
+*/
+static void loadCache(void);
+
+
+/*
+* Description:
+*      Stores the word and its date in NVS and RAM
+*      Also called by the rollover timer
+* 
+* Arguments:
+*     uint32_t dateKey: The date the word belongs to
+*     const char *word: The word to store
+* 
+* Returns:
+*      None
+*/
+static void storeCache(uint32_t dateKey, const char *word);
+
+/*-----------------------------------------------------------
+Functions
+------------------------------------------------------------*/
+
+static bool getDateKey(uint32_t *dateKey)
+{
+    struct tm date;
+    time_t now = time(NULL) + API_UTC_OFFSET_HOURS * 3600;
+
+    gmtime_r(&now, &date);
+
+    if(date.tm_year + 1900 < MIN_VALID_YEAR)
+    {
+        return false;
+    }
+
+    *dateKey = (date.tm_year + 1900) * 10000 + (date.tm_mon + 1) * 100 + date.tm_mday;
+
+    return true;
+}
+
+static int32_t secondsToMidnight(uint32_t *dateKey)
+{
+    struct tm date;
+    time_t now = time(NULL) + API_UTC_OFFSET_HOURS * 3600;
+    time_t midnight;
+
+    gmtime_r(&now, &date);
+
+    if(date.tm_year + 1900 < MIN_VALID_YEAR)
+    {
+        return -1;
+    }
+
+    midnight = now - now % SECONDS_PER_DAY + SECONDS_PER_DAY;
+    gmtime_r(&midnight, &date);
+    *dateKey = (date.tm_year + 1900) * 10000 + (date.tm_mon + 1) * 100 + date.tm_mday;
+
+    return midnight - now;
+}
+
+static void armRollover(rolloverPhase_t phase, int32_t delaySeconds)
+{
+    rolloverPhase = phase;
+    esp_timer_stop(rolloverTimer);
+    esp_timer_start_once(rolloverTimer, (uint64_t)(delaySeconds > 0 ? delaySeconds : 1) * 1000000);
+}
+
+static void rolloverCallback(void *arg)
+{
+    char word[WORD_SIZE] = {0};
+    uint32_t today;
+    int32_t toMidnight = secondsToMidnight(&rolloverDate);
+
+    if(toMidnight < 0)
+    {
+        armRollover(ROLLOVER_WAIT, ROLLOVER_CLOCK_RETRY_S);
+        return;
+    }
+
+    switch(rolloverPhase)
+    {
+        case ROLLOVER_WAIT:
+            if(toMidnight > ROLLOVER_PREFETCH_LEAD_S)
+            {
+                armRollover(ROLLOVER_PREFETCH, toMidnight - ROLLOVER_PREFETCH_LEAD_S);
+            }
+            else if(toMidnight > ROLLOVER_COLLECT_LEAD_S)
+            {
+                // Too late for the usual lead, prefetch right away
+                armRollover(ROLLOVER_PREFETCH, 0);
+            }
+            else
+            {
+                armRollover(ROLLOVER_WAIT, toMidnight + 1);
+            }
+            break;
+
+        case ROLLOVER_PREFETCH:
+            ESP_LOGI(LOG_TAG, "Prefetching the word for %lu", (unsigned long)rolloverDate);
+            nextWordRequest = api_request_get_next_word();
+            armRollover(ROLLOVER_COLLECT, toMidnight - ROLLOVER_COLLECT_LEAD_S);
+            break;
+
+        case ROLLOVER_COLLECT:
+            if(nextWordRequest != NULL && api_request_poll(nextWordRequest) == API_REQUEST_DONE &&
+               api_request_take(nextWordRequest, word, WORD_SIZE) == ESP_OK && isWordComplete(word))
+            {
+                nextDate = rolloverDate;
+                memcpy(nextWord, word, WORD_SIZE);
+
+                ESP_LOGI(LOG_TAG, "Word for %lu ready", (unsigned long)rolloverDate);
+
+                nextWordRequest = NULL;
+                armRollover(ROLLOVER_SWAP, toMidnight + 1);
+                break;
+            }
+            else
+            {
+                // The first game of the day fetches it instead
+                if(nextWordRequest != NULL && api_request_poll(nextWordRequest) != API_REQUEST_DONE)
+                {
+                    api_request_cancel(nextWordRequest);
+                }
+
+                ESP_LOGW(LOG_TAG, "Word for %lu not prefetched", (unsigned long)rolloverDate);
+            }
+
+            nextWordRequest = NULL;
+            armRollover(ROLLOVER_WAIT, toMidnight + 1);
+            break;
+
+        case ROLLOVER_SWAP:
+            // Persisted now, so a reboot after midnight does not lose it
+            if(getDateKey(&today) && today == nextDate)
+            {
+                ESP_LOGI(LOG_TAG, "Switching to the word for %lu", (unsigned long)nextDate);
+                storeCache(nextDate, nextWord);
+            }
+
+            nextDate = 0;
+            armRollover(ROLLOVER_WAIT, 0);
+            break;
+    }
+}
+
+static uint32_t dateKeyToDay(uint32_t dateKey)
+{
+    int32_t year = dateKey / 10000;
+    int32_t month = (dateKey / 100) % 100;
+    int32_t day = dateKey % 100;
+    int32_t era;
+    int32_t yearOfEra;
+    int32_t dayOfYear;
+
+    // Days from civil (Howard Hinnant), years start in March so Feb 29 is last
+    year -= (month <= 2);
+    era = year / 400;
+    yearOfEra = year - era * 400;
+    dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+
+    return era * 146097 + yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear - 719468;
+}
+
+static uint32_t gcd(uint32_t a, uint32_t b)
+{
+    uint32_t remainder;
+
+    while(b != 0)
+    {
+        remainder = a % b;
+        a = b;
+        b = remainder;
+    }
+
+    return a;
+}
+
+static void loadCache(void)
+{
+    nvs_handle_t handle;
+    uint32_t date = 0;
+    char word[WORD_SIZE];
+    size_t wordSize = sizeof(word);
+
+    if(nvs_open(NVS_NAMESPACE, NVS_READONLY, &handle) != ESP_OK)
+    {
+        return;
+    }
+
+    if(nvs_get_u32(handle, NVS_KEY_DATE, &date) != ESP_OK ||
+       nvs_get_str(handle, NVS_KEY_WORD, word, &wordSize) != ESP_OK ||
+       !isWordComplete(word))
+    {
+        date = 0;
+    }
+
+    nvs_close(handle);
+
+    // The rollover timer may have stored a newer word in the meantime
+    taskENTER_CRITICAL(&cacheLock);
+    if(cachedDate == 0 && date != 0)
+    {
+        cachedDate = date;
+        memcpy(cachedWord, word, WORD_SIZE);
+    }
+    taskEXIT_CRITICAL(&cacheLock);
+}
+
+static void storeCache(uint32_t dateKey, const char *word)
+{
+    nvs_handle_t handle;
+    esp_err_t ret = ESP_OK;
+
+    taskENTER_CRITICAL(&cacheLock);
+    cachedDate = dateKey;
+    strlcpy(cachedWord, word, sizeof(cachedWord));
+    taskEXIT_CRITICAL(&cacheLock);
+
+    if(nvs_open(NVS_NAMESPACE, NVS_READWRITE, &handle) != ESP_OK)
+    {
+        ESP_LOGW(LOG_TAG, "Could not open NVS, word not cached");
+        return;
+    }
+
+    ret |= nvs_set_u32(handle, NVS_KEY_DATE, dateKey);
+    ret |= nvs_set_str(handle, NVS_KEY_WORD, word);
+    ret |= nvs_commit(handle);
+
+    if(ret != ESP_OK)
+    {
+        ESP_LOGW(LOG_TAG, "Failed to cache word in NVS");
+    }
+
+    nvs_close(handle);
+}
+
+bool dailyWordFromCache(char *word, int wordSize)
+{
+    uint32_t today;
+    bool isCached;
+
+    if(word == NULL || wordSize < WORD_SIZE)
+    {
+        return false;
+    }
+
+    if(cachedDate == 0)
+    {
+        loadCache();
+    }
+
+    if(!getDateKey(&today))
+    {
+        return false;
+    }
+
+    // Serve from the cache when it is still the same day (or the rollover already swapped it)
+    taskENTER_CRITICAL(&cacheLock);
+    isCached = (cachedDate == today);
+    if(isCached)
+    {
+        memcpy(word, cachedWord, WORD_SIZE);
+    }
+    taskEXIT_CRITICAL(&cacheLock);
+
+    if(isCached)
+    {
+        ESP_LOGI(LOG_TAG, "Using cached word for %lu", (unsigned long)today);
+    }
+
+    return isCached;
+}
+
+bool dailyWordToday(uint32_t *dateKey)
+{
+    if(dateKey == NULL)
+    {
+        return false;
+    }
+
+    return getDateKey(dateKey);
+}
+
+void dailyWordSave(const char *word)
+{
+    uint32_t today;
+    bool isNew;
+
+    if(word == NULL || !isWordComplete(word))
+    {
+        return;
+    }
+
+    // The fetch may have just set the clock from the server's date
+    if(!getDateKey(&today))
+    {
+        ESP_LOGW(LOG_TAG, "Date unknown, word not cached");
+        return;
+    }
+
+    taskENTER_CRITICAL(&cacheLock);
+    isNew = (cachedDate != today || strncmp(cachedWord, word, WORD_SIZE) != 0);
+    taskEXIT_CRITICAL(&cacheLock);
+
+    if(isNew)
+    {
+        storeCache(today, word);
+    }
+}
+
+bool dailyWordOffline(char *word, int wordSize)
+{
+    uint32_t answerCount = wordDictionaryAnswerCount();
+    uint32_t dateKey;
+    uint32_t day = 0;
+    uint32_t step = OFFLINE_STEP;
+
+    if(word == NULL || wordSize < WORD_SIZE || answerCount == 0)
+    {
+        return false;
+    }
+
+    if(cachedDate == 0)
+    {
+        loadCache();
+    }
+
+    // Prefer the clock, then the last day the api served a word, then a fixed day
+    if(getDateKey(&dateKey))
+    {
+        day = dateKeyToDay(dateKey);
+    }
+    else if(cachedDate != 0)
+    {
+        dateKey = cachedDate;
+        day = dateKeyToDay(dateKey);
+    }
+    else
+    {
+        dateKey = 0;
+    }
+
+    while(gcd(step, answerCount) != 1)
+    {
+        step++;
+    }
+
+    wordDictionaryUnpack(wordDictionaryGetAnswer(((uint64_t)day * step + OFFLINE_OFFSET) % answerCount), word);
+
+    ESP_LOGI(LOG_TAG, "Picked offline word for %lu", (unsigned long)dateKey);
+
+    // Not cached, the api's word replaces it once the network is back
+    return true;
+}
+
+void dailyWordStartRollover(void)
+{
+    const esp_timer_create_args_t timerArgs = {
+        .callback = rolloverCallback,
+        .name = "word_rollover"
+    };
+
+    if(rolloverTimer != NULL)
+    {
+        return;
+    }
+
+    if(esp_timer_create(&timerArgs, &rolloverTimer) != ESP_OK)
+    {
+        ESP_LOGE(LOG_TAG, "Could not create the rollover timer");
+        return;
+    }
+
+    armRollover(ROLLOVER_WAIT, 0);
+}
@@ -0,0 +1,244 @@
+#include "esp_log.h"
+#include "esp_rom_crc.h"
+#include <stdio.h>
+#include <string.h>
+#include "nvs.h"
+#include "wordGuessCore.h"
+#include "gameCheckpoint.h"
+
+/*-----------------------------------------------------------
+Literal Constants
+------------------------------------------------------------*/
+
+#define LOG_TAG "GameCheckpoint"
+
+#define NVS_NAMESPACE   "game_ckpt"
+#define SLOT_KEY_FORMAT "slot%d"
+#define SLOT_KEY_SIZE   8
+
+// Slots written in turn, the newest has the highest sequence number
+#define SLOT_COUNT 4
+
+// Slot layout: sequence (4 bytes), record size (1 byte), the record, then the CRC-32 of everything before it
+#define SLOT_SIZE_OFFSET    4
+#define SLOT_HEADER_SIZE    5
+#define SLOT_CRC_SIZE       4
+#define SLOT_MAX_SIZE       (SLOT_HEADER_SIZE + WORD_GUESS_CHECKPOINT_MAX_SIZE + SLOT_CRC_SIZE)
+
+/*-----------------------------------------------------------
+Statics
+------------------------------------------------------------*/
+
+static bool isScanned = false;
+static uint8_t newestSlot = SLOT_COUNT - 1;     // The first write goes to slot 0
+static uint32_t newestSequence = 0;
+static uint8_t newestRecord[WORD_GUESS_CHECKPOINT_MAX_SIZE];
+static size_t newestSize = 0;
+
+/*-----------------------------------------------------------
+Local Function Prototypes
+------------------------------------------------------------*/
+
+/*
+* Description:
+*      Reads a slot and checks it
+* 
+* Arguments:
+*     nvs_handle_t handle: The open namespace
+*     uint8_t slot: The slot to read
+*     uint32_t *sequence: Where to store its sequence number
+*     uint8_t *record: Buffer for the record (WORD_GUESS_CHECKPOINT_MAX_SIZE bytes)
+*     size_t *size: Where to store the record size
+* 
+* Returns:
+*      True if the slot holds a whole record with a matching CRC
+*      False otherwise
+*/
+static bool readSlot(nvs_handle_t handle, uint8_t slot, uint32_t *sequence, uint8_t *record, size_t *size);
+
+
+/*
+* Description:
+*      Finds the newest good slot, once per boot
+* 
+* Arguments:
+*     None
+* 
+* Returns:
+*      None
+*/
+static void scanSlots(void);
+
+
+/*
+* Description:
+*      Reads a little endian 32 bit value
+* 
+* Arguments:
+*     const uint8_t *bytes: The 4 bytes
+* 
+* Returns:
+*      uint32_t: The value
+*/
+static uint32_t readU32(const uint8_t *bytes);
+
+/*-----------------------------------------------------------
+Functions
+------------------------------------------------------------*/
+
+static uint32_t readU32(const uint8_t *bytes)
+{
+    return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+}
+
+static bool readSlot(nvs_handle_t handle, uint8_t slot, uint32_t *sequence, uint8_t *record, size_t *size)
+{
+    char key[SLOT_KEY_SIZE];
+    uint8_t blob[SLOT_MAX_SIZE];
+    size_t blobSize = sizeof(blob);
+    size_t recordSize;
+
+    snprintf(key, sizeof(key), SLOT_KEY_FORMAT, slot);
+
+    if(nvs_get_blob(handle, key, blob, &blobSize) != ESP_OK || blobSize < SLOT_HEADER_SIZE + SLOT_CRC_SIZE)
+    {
+        return false;
+    }
+
+    recordSize = blob[SLOT_SIZE_OFFSET];
+
+    if(recordSize > WORD_GUESS_CHECKPOINT_MAX_SIZE || blobSize != SLOT_HEADER_SIZE + recordSize + SLOT_CRC_SIZE ||
+       readU32(&blob[SLOT_HEADER_SIZE + recordSize]) != esp_rom_crc32_le(0, blob, SLOT_HEADER_SIZE + recordSize))
+    {
+        ESP_LOGW(LOG_TAG, "Slot %d is damaged, skipped", slot);
+        return false;
+    }
+
+    *sequence = readU32(blob);
+    memcpy(record, &blob[SLOT_HEADER_SIZE], recordSize);
+    *size = recordSize;
+
+    return true;
+}
+
+static void scanSlots(void)
+{
+    nvs_handle_t handle;
+    uint32_t sequence;
+    uint8_t record[WORD_GUESS_CHECKPOINT_MAX_SIZE];
+    size_t size;
+    bool isFound = false;
+
+    if(isScanned)
+    {
+        return;
+    }
+
+    isScanned = true;
+
+    if(nvs_open(NVS_NAMESPACE, NVS_READONLY, &handle) != ESP_OK)
+    {
+        return;
+    }
+
+    for(uint8_t slot = 0; slot < SLOT_COUNT; slot++)
+    {
+        if(readSlot(handle, slot, &sequence, record, &size) && (!isFound || sequence > newestSequence))
+        {
+            isFound = true;
+            newestSlot = slot;
+            newestSequence = sequence;
+            newestSize = size;
+            memcpy(newestRecord, record, size);
+        }
+    }
+
+    nvs_close(handle);
+}
+
+bool gameCheckpointLoad(void *record, size_t *size)
+{
+    scanSlots();
+
+    if(record == NULL || size == NULL || newestSize == 0 || *size < newestSize)
+    {
+        return false;
+    }
+
+    memcpy(record, newestRecord, newestSize);
+    *size = newestSize;
+
+    return true;
+}
+
+void gameCheckpointSave(const void *record, size_t size)
+{
+    nvs_handle_t handle;
+    char key[SLOT_KEY_SIZE];
+    uint8_t blob[SLOT_MAX_SIZE];
+    uint8_t slot;
+    uint32_t sequence;
+    uint32_t crc;
+    esp_err_t ret = ESP_OK;
+
+    if(size > WORD_GUESS_CHECKPOINT_MAX_SIZE || (record == NULL && size != 0))
+    {
+        ESP_LOGE(LOG_TAG, "Invalid checkpoint");
+        return;
+    }
+
+    // Carry on from the newest slot written before this boot
+    scanSlots();
+
+    slot = (newestSlot + 1) % SLOT_COUNT;
+    sequence = newestSequence + 1;
+
+    for(uint8_t byte = 0; byte < sizeof(sequence); byte++)
+    {
+        blob[byte] = sequence >> (byte * 8);
+    }
+
+    blob[SLOT_SIZE_OFFSET] = size;
+
+    if(size > 0)
+    {
+        memcpy(&blob[SLOT_HEADER_SIZE], record, size);
+    }
+
+    crc = esp_rom_crc32_le(0, blob, SLOT_HEADER_SIZE + size);
+
+    for(uint8_t byte = 0; byte < sizeof(crc); byte++)
+    {
+        blob[SLOT_HEADER_SIZE + size + byte] = crc >> (byte * 8);
+    }
+
+    if(nvs_open(NVS_NAMESPACE, NVS_READWRITE, &handle) != ESP_OK)
+    {
+        ESP_LOGW(LOG_TAG, "Could not open NVS, game not saved");
+        return;
+    }
+
+    snprintf(key, sizeof(key), SLOT_KEY_FORMAT, slot);
+
+    ret |= nvs_set_blob(handle, key, blob, SLOT_HEADER_SIZE + size + SLOT_CRC_SIZE);
+    ret |= nvs_commit(handle);
+
+    nvs_close(handle);
+
+    if(ret != ESP_OK)
+    {
+        ESP_LOGW(LOG_TAG, "Failed to save the game in NVS");
+        return;
+    }
+
+    newestSlot = slot;
+    newestSequence = sequence;
+    newestSize = size;
+
+    if(size > 0)
+    {
+        memcpy(newestRecord, record, size);
+    }
+
+    ESP_LOGD(LOG_TAG, "Saved %d bytes to slot %d", (int)size, slot);
+}
@@ -0,0 +1,74 @@
+#include <stdint.h>
+#include "guessEvaluator.h"
+
+/*-----------------------------------------------------------
+Literal Constants
+------------------------------------------------------------*/
+
+#define LETTER_COUNT 26
+
+/*-----------------------------------------------------------
+Macros
+------------------------------------------------------------*/
+
+// Maps 'a'-'z' and 'A'-'Z' to 0 - 25, anything else to >= LETTER_COUNT
+#define LETTER_INDEX(c) ((uint8_t)(((c) | 0x20) - 'a'))
+
+/*-----------------------------------------------------------
+Functions
+------------------------------------------------------------*/
+
+void evaluateGuess(const char *guess, const char *target, char *result)
+{
+    uint8_t letterCounts[LETTER_COUNT] = {0};
+    uint8_t guessIndex;
+    uint8_t targetIndex;
+
+    // First pass, mark the letters in the right spot and count the rest of the target
+    for(uint8_t pos = 0; pos < GUESS_LETTER_COUNT; pos++)
+    {
+        guessIndex = LETTER_INDEX(guess[pos]);
+        targetIndex = LETTER_INDEX(target[pos]);
+
+        if(guessIndex < LETTER_COUNT && guessIndex == targetIndex)
+        {
+            result[pos] = RESULT_CORRECT;
+        }
+        else
+        {
+            result[pos] = RESULT_WRONG;
+
+            if(targetIndex < LETTER_COUNT)
+            {
+                letterCounts[targetIndex]++;
+            }
+        }
+    }
+
+    // Second pass, each unmatched target letter can mark one misplaced guess letter
+    for(uint8_t pos = 0; pos < GUESS_LETTER_COUNT; pos++)
+    {
+        guessIndex = LETTER_INDEX(guess[pos]);
+
+        if(result[pos] != RESULT_CORRECT && guessIndex < LETTER_COUNT && letterCounts[guessIndex] > 0)
+        {
+            letterCounts[guessIndex]--;
+            result[pos] = RESULT_SWAP;
+        }
+    }
+
+    result[GUESS_LETTER_COUNT] = '\0';
+}
+
+bool isWordComplete(const char *word)
+{
+    for(uint8_t pos = 0; pos < GUESS_LETTER_COUNT; pos++)
+    {
+        if(LETTER_INDEX(word[pos]) >= LETTER_COUNT)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*-----------------------------------------------------------
+Function Prototypes
+------------------------------------------------------------*/
+
+/*
+* Description:
+*      Gets today's word from the NVS cache
+*      The api only needs to be called when this misses (first game
+*      of the day, or the date is not known yet)
+* 
+* Arguments:
+*     char *word: Buffer to store the word (must account for null terminator)
+*     int wordSize: The size of the buffer
+* 
+* Returns:
+*      True if today's word was in the cache
+*      False if the word needs to be fetched
+*/
+bool dailyWordFromCache(char *word, int wordSize);
+
+
+/*
+* Description:
+*      Gets today's date in the api's timezone, the day the daily word
+*      belongs to
+* 
+* Arguments:
+*     uint32_t *dateKey: Where to store the date (YYYYMMDD)
+* 
+* Returns:
+*      True if the clock is set
+*      False if the date is not known
+*/
+bool dailyWordToday(uint32_t *dateKey);
+
+
+/*
+* Description:
+*      Stores a freshly fetched word in the cache under today's date
+*      Nothing is stored if the date is not known
+* 
+* Arguments:
+*     const char *word: The word to store
+* 
+* Returns:
+*      None
+*/
+void dailyWordSave(const char *word);
+
+
+/*
+* Description:
+*      Picks today's word from the dictionary's answer list without the api
+*      The pick only depends on the date, so every device agrees on it
+*      Falls back to the last cached date, or a fixed word, if the clock is not set
+* 
+* Arguments:
+*     char *word: Buffer to store the word (must account for null terminator)
+*     int wordSize: The size of the buffer
+* 
+* Returns:
+*      True if a word was picked
+*      False if the dictionary has no answers
+*/
+bool dailyWordOffline(char *word, int wordSize);
+
+
+/*
+* Description:
+*      Starts a timer that requests tomorrow's word a few minutes before
+*      midnight, so the first game of the new day does not wait on the api
+*      The word goes into the cache when the date rolls over
+*      Waits for the clock to be set if it is not yet
+* 
+* Arguments:
+*     None
+* 
+* Returns:
+*      None
+*/
+void dailyWordStartRollover(void);
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/*-----------------------------------------------------------
+Function Prototypes
+------------------------------------------------------------*/
+
+/*
+* Description:
+*      Gets the newest game checkpoint from NVS
+*      Every slot is checked against its CRC, a slot that was cut short or
+*      went bad is skipped for the one written before it
+* 
+* Arguments:
+*     void *record: Buffer for the record (WORD_GUESS_CHECKPOINT_MAX_SIZE bytes)
+*     size_t *size: Size of the buffer, set to the size of the record
+* 
+* Returns:
+*      True if there is a game to resume
+*      False if there is none, or the last one was cleared
+*/
+bool gameCheckpointLoad(void *record, size_t *size);
+
+
+/*
+* Description:
+*      Stores a game checkpoint in the next of the NVS slots, so writes go
+*      round the slots and the one before is kept if this one is cut short
+*      Matches saveGame in wordGuessBackend_t
+* 
+* Arguments:
+*     const void *record: The record, NULL to clear the checkpoint
+*     size_t size: Its size (at most WORD_GUESS_CHECKPOINT_MAX_SIZE), 0 to clear
+* 
+* Returns:
+*      None
+*/
+void gameCheckpointSave(const void *record, size_t size);
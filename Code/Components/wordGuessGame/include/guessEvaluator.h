@@ -0,0 +1,51 @@
+#pragma once
+
+#include <stdbool.h>
+
+/*-----------------------------------------------------------
+Literal Constants
+------------------------------------------------------------*/
+
+#define GUESS_LETTER_COUNT 5
+
+// Result characters, same format the API returns
+#define RESULT_CORRECT  '+'
+#define RESULT_SWAP     'x'
+#define RESULT_WRONG    '-'
+
+/*-----------------------------------------------------------
+Function Prototypes
+------------------------------------------------------------*/
+
+/*
+* Description:
+*      Computes the result pattern of a guess against the target word
+*      locally, using the same '+', 'x', '-' format as the API
+*
+*      Duplicate letters follow the usual rules: letters in the right
+*      spot are matched first, then each remaining target letter can
+*      mark at most one misplaced guess letter (left to right)
+*
+* Arguments:
+*     const char *guess: The guessed word (GUESS_LETTER_COUNT letters, any case)
+*     const char *target: The word to guess (GUESS_LETTER_COUNT letters, any case)
+*     char *result: Buffer for the result (GUESS_LETTER_COUNT + 1 chars, null terminated)
+*
+* Returns:
+*      None
+*/
+void evaluateGuess(const char *guess, const char *target, char *result);
+
+
+/*
+* Description:
+*      Checks that the word is made of GUESS_LETTER_COUNT letters
+*
+* Arguments:
+*     const char *word: The word to check
+*
+* Returns:
+*      True if every character is a letter
+*      False otherwise
+*/
+bool isWordComplete(const char *word);
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <stdint.h>
+#include "wordSolver.h"
+
+/*-----------------------------------------------------------
+Types
+------------------------------------------------------------*/
+
+// Hints for the first two guesses, worked out on the host (see Code/host/tools/gen_opening_book.c)
+typedef struct
+{
+    // The dictionary the book was made for, it is not used with any other
+    uint32_t wordCount;
+    uint32_t answerCount;
+
+    // Packed suggestion for the first guess
+    uint32_t opener;
+
+    // Packed suggestion for the second guess, by the result of the opener as a
+    // pattern number (see wordSolverFirstResult)
+    // DICTIONARY_INVALID_WORD where no answer gives that result
+    uint32_t replies[WORD_SOLVER_PATTERN_COUNT];
+} openingBook_t;
+
+extern const openingBook_t openingBook;
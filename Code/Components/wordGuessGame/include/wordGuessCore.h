@@ -0,0 +1,251 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <esp_err.h>
+#include <matrixDisplay.h>
+
+/*-----------------------------------------------------------
+Literal Constants
+------------------------------------------------------------*/
+
+// Action button LEDs, bits for setButtonLeds
+#define WORD_GUESS_LED_SELECT   (1 << 0)
+#define WORD_GUESS_LED_GUESS    (1 << 1)
+#define WORD_GUESS_LED_DELETE   (1 << 2)
+#define WORD_GUESS_LED_EXIT     (1 << 3)
+
+// Largest record handed to saveGame
+#define WORD_GUESS_CHECKPOINT_MAX_SIZE 40
+
+/*-----------------------------------------------------------
+Types
+------------------------------------------------------------*/
+
+typedef enum
+{
+    INIT,
+    LETTER_SELECTION,
+    LETTER_EDIT,
+    RESULTS,
+    HISTORY,    // An earlier guess and its result showing, the board comes back on leaving
+    EXITED,     // Exit screen showing, the game is over until wordGuessCoreReset
+
+    WORD_GUESS_STATE_COUNT
+} wordGuessGameStates_t;
+
+// What the player did, one event per press (a held LEFT or RIGHT repeats)
+typedef enum
+{
+    WORD_GUESS_EVENT_SELECT,
+    WORD_GUESS_EVENT_GUESS,
+    WORD_GUESS_EVENT_DELETE,
+    WORD_GUESS_EVENT_EXIT,
+    WORD_GUESS_EVENT_LEFT,
+    WORD_GUESS_EVENT_RIGHT,
+    WORD_GUESS_EVENT_UP,
+    WORD_GUESS_EVENT_DOWN,
+
+    WORD_GUESS_EVENT_COUNT
+} wordGuessEvent_t;
+
+// Everything the game needs from outside the display, the device wires these
+// to the buttons, the api and FreeRTOS, the host simulator to stubs
+typedef struct
+{
+    // Lights the action buttons that can be pressed (WORD_GUESS_LED_* bits)
+    void (*setButtonLeds)(uint8_t leds);
+
+    // Gets the word for a new game (5 letters), false if there is none
+    // The results then come from checkGuess
+    bool (*getWordToGuess)(char *word, int wordSize);
+
+    // Gets the result of a guess from the api ('+', 'x', '-'), false if it could not be reached
+    bool (*checkGuess)(const char *guess, char *result, int resultSize);
+
+    // Shows the hint, GUESS pressed while selecting a letter
+    void (*showHint)(void);
+
+    // Waits between the frames of an animation
+    void (*delayMs)(uint32_t ms);
+
+    // Gets today's date as YYYYMMDD, the day the word to guess belongs to
+    // False if the date is not known, checkpoints are then saved without one
+    bool (*getDate)(uint32_t *dateKey);
+
+    // Keeps the game through a reset, called after every guess that does not end it
+    // A NULL record (size 0) once there is nothing to resume, give the last one kept to wordGuessCoreResume
+    void (*saveGame)(const void *record, size_t size);
+} wordGuessBackend_t;
+
+/*-----------------------------------------------------------
+Function Prototypes
+------------------------------------------------------------*/
+
+/*
+* Description:
+*      Hooks the game up to its backend and lights the buttons for the
+*      start screen. Every callback must be set
+*
+* Arguments:
+*     const wordGuessBackend_t *backend: The backend (kept, not copied)
+*
+* Returns:
+*      esp_err_t: ESP_OK if the backend was accepted
+*/
+esp_err_t wordGuessCoreInit(const wordGuessBackend_t *backend);
+
+
+/*
+* Description:
+*      Clears the board and gets a new word to guess from the backend
+*      The game waits on the start screen (INIT) afterwards
+*
+* Arguments:
+*     None
+*
+* Returns:
+*      esp_err_t: ESP_OK if the board was reset
+*/
+esp_err_t wordGuessCoreReset(void);
+
+
+/*
+* Description:
+*      Picks a game back up from a record given to saveGame, without
+*      asking the backend for the word. The results are played back into
+*      the solver and the board is drawn as it was after the last guess
+*      The game waits in LETTER_EDIT afterwards
+*
+* Arguments:
+*     const void *record: The record
+*     size_t size: Its size
+*
+* Returns:
+*      esp_err_t: ESP_OK if the game was resumed
+*                 ESP_ERR_INVALID_ARG or ESP_ERR_INVALID_SIZE if the record is not a game
+*/
+esp_err_t wordGuessCoreResume(const void *record, size_t size);
+
+
+/*
+* Description:
+*      Gets the day a record given to saveGame was saved on, so a game
+*      left over from another day can be dropped instead of resumed
+*
+* Arguments:
+*     const void *record: The record
+*     size_t size: Its size
+*
+* Returns:
+*      uint32_t: The date (YYYYMMDD), 0 if it is not known or the record is not a game
+*/
+uint32_t wordGuessCoreCheckpointDate(const void *record, size_t size);
+
+
+/*
+* Description:
+*      Runs the game one step for a button press
+*      The handler for the event in the current state is looked up in a
+*      (state, event) table, and the entry and exit actions run when it
+*      changes the state. The button LEDs only change on a state change
+*      Pressing SELECT on the start screen starts a new game
+*      Nothing is handled once the game is exited
+*      GUESS on an empty row or on the last guess again, or LEFT or RIGHT
+*      once the game is over, shows the earlier guesses (HISTORY)
+*
+* Arguments:
+*     wordGuessEvent_t event: The button pressed
+*
+* Returns:
+*      True while the game is running
+*      False once the player exits (EXITED)
+*/
+bool wordGuessCoreHandleEvent(wordGuessEvent_t event);
+
+
+/*
+* Description:
+*      Gets the state the game is in
+*
+* Arguments:
+*     None
+*
+* Returns:
+*      wordGuessGameStates_t: The state
+*/
+wordGuessGameStates_t wordGuessCoreGetState(void);
+
+
+/*
+* Description:
+*      Gets the number of incorrect guesses made this game
+*
+* Arguments:
+*     None
+*
+* Returns:
+*      uint16_t: The number of guesses
+*/
+uint16_t wordGuessCoreGetGuessCount(void);
+
+
+/*
+* Description:
+*      Steps the screen brightness up or down by one level
+*      Also used while the backend is busy (e.g. waiting on the api)
+*
+* Arguments:
+*     direction_t direction: UP to increase, DOWN to decrease
+*
+* Returns:
+*     None
+*/
+void wordGuessCoreChangeBrightness(direction_t direction);
+
+
+/*
+* Description:
+*      Sets whether the carousal steps over letters the results showed are
+*      not in the word. Letters known to be in the word are underlined
+*      either way
+*
+* Arguments:
+*     bool isSkipping: True to skip absent letters
+*
+* Returns:
+*     None
+*/
+void wordGuessCoreSkipAbsentLetters(bool isSkipping);
+
+
+/*
+* Description:
+*      Gets how long to wait before the next step of a held LEFT or RIGHT
+*      The steps come quicker the longer the button is held, from 150 ms
+*      apart down to 25 ms, which turns the carousal through the whole
+*      alphabet in under a second
+*
+* Arguments:
+*     uint16_t repeats: Steps already taken since the button went down
+*
+* Returns:
+*      uint32_t: The wait in ms
+*/
+uint32_t wordGuessCoreHoldDelay(uint16_t repeats);
+
+
+/*
+* Description:
+*      Sets how long the carousal takes to slide to the next letter
+*      A pixel column a frame, frames are dropped when it is short and
+*      0 jumps straight to the letter
+*
+* Arguments:
+*     uint32_t slideMs: The slide time in ms
+*
+* Returns:
+*     None
+*/
+void wordGuessCoreSetSlideTime(uint32_t slideMs);
@@ -29,6 +29,21 @@ Function Prototypes
 esp_err_t wordGuessGameReset(void);
 
 
+/*
+* Description:
+*      Starts fetching today's word in the background
+*      Call once the network is up, wordGuessGameReset picks the word up
+*      when the player starts a game
+* 
+* Arguments:
+*     None
+* 
+* Returns:
+*      None
+*/
+void wordGuessGamePrefetch(void);
+
+
 /*
 * Description:
 *      Starts the word guess game 
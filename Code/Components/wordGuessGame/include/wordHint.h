@@ -0,0 +1,51 @@
+#pragma once
+
+#include <stdbool.h>
+#include <esp_err.h>
+
+/*-----------------------------------------------------------
+Types
+------------------------------------------------------------*/
+
+// Called by wordHintSuggest while it waits, every HINT_PROGRESS_MS
+// Returns true to stop the search (e.g. a button was pressed)
+typedef bool (*wordHintProgress_t)(void);
+
+/*-----------------------------------------------------------
+Function Prototypes
+------------------------------------------------------------*/
+
+/*
+* Description:
+*      Starts one hint worker task on each core
+*      The workers sleep until wordHintSuggest hands them work
+*
+* Arguments:
+*     None
+*
+* Returns:
+*      esp_err_t: ESP_OK if the workers were started
+*                 ESP_ERR_NO_MEM if not, nothing is left behind and hints stay off
+*/
+esp_err_t wordHintInit(void);
+
+
+/*
+* Description:
+*      Finds the guess that is expected to narrow down the answers left in
+*      wordSolver the most. Every word in the dictionary is scored against
+*      every answer left, split across the cores in chunks, and a core
+*      that runs out of chunks steals half of what the other has left
+*      The first two hints come from the opening book without a search
+*      Blocks until done or stopped, the time taken is logged
+*
+* Arguments:
+*     char *word: Buffer for the suggestion (6 chars, lowercase, null terminated)
+*     int wordSize: The size of the buffer
+*     wordHintProgress_t progress: Called while waiting, can stop the search (NULL for none)
+*
+* Returns:
+*      True if a suggestion was found
+*      False if the search was stopped or there is nothing to suggest
+*/
+bool wordHintSuggest(char *word, int wordSize, wordHintProgress_t progress);
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*-----------------------------------------------------------
+Literal Constants
+------------------------------------------------------------*/
+
+#define WORD_SOLVER_PATTERN_COUNT 243   // 3^5 possible results of a guess
+
+/*-----------------------------------------------------------
+Function Prototypes
+------------------------------------------------------------*/
+
+/*
+* Description:
+*      Builds the letter masks over the dictionary's answer list
+*      Every answer is one bit, so a set of answers is a bitset and each
+*      result narrows it with a few word-wide ANDs
+*
+* Arguments:
+*     None
+*
+* Returns:
+*      True if the solver is ready
+*      False if the dictionary has no answers or the masks could not be allocated
+*/
+bool wordSolverInit(void);
+
+
+/*
+* Description:
+*      Makes every answer a candidate again, for a new game
+*
+* Arguments:
+*     None
+*
+* Returns:
+*      None
+*/
+void wordSolverReset(void);
+
+
+/*
+* Description:
+*      Removes the candidates that would not have given this result
+*
+* Arguments:
+*     const char *guess: The guessed word (5 letters, any case)
+*     const char *result: Its result in the api format ('+', 'x', '-')
+*
+* Returns:
+*      True if the result was applied
+*      False if the solver is not ready or the result is unknown ('?')
+*/
+bool wordSolverApply(const char *guess, const char *result);
+
+
+/*
+* Description:
+*      Gets the number of answers that still fit every result so far
+*
+* Arguments:
+*     None
+*
+* Returns:
+*      uint32_t: The number of candidates, 0 if the solver is not ready
+*/
+uint32_t wordSolverCandidateCount(void);
+
+
+/*
+* Description:
+*      Gets the number of results applied since the last reset
+*
+* Arguments:
+*     None
+*
+* Returns:
+*      uint8_t: The number of results
+*/
+uint8_t wordSolverAppliedCount(void);
+
+
+/*
+* Description:
+*      Gets the first guess of the game and its result
+*
+* Arguments:
+*     uint32_t *guess: Where to store the packed guess
+*     uint8_t *pattern: Where to store the result as a base 3 number, one
+*                       digit per letter from the first ('-' = 0, 'x' = 1, '+' = 2)
+*
+* Returns:
+*      True if a result has been applied
+*      False otherwise
+*/
+bool wordSolverFirstResult(uint32_t *guess, uint8_t *pattern);
+
+
+/*
+* Description:
+*      Lists the candidates by their position in the answer list
+*      (see wordDictionaryGetAnswer), in alphabetical order
+*
+* Arguments:
+*     uint32_t *positions: Buffer for the positions
+*     uint32_t maxCount: Size of the buffer
+*
+* Returns:
+*      uint32_t: The number of positions written
+*/
+uint32_t wordSolverListCandidates(uint32_t *positions, uint32_t maxCount);
+
+
+/*
+* Description:
+*      Scores a guess by the information its result is expected to give
+*      (entropy of the result distribution over the answers), in bits
+*      Guesses that can be the answer get a small bonus (1 / answerCount)
+*
+* Arguments:
+*     uint32_t guess: The packed guess (see wordDictionaryPack)
+*     const uint32_t *answers: The packed answers still possible
+*     uint32_t answerCount: The number of answers (at most 65535)
+*
+* Returns:
+*      float: The score, higher is better
+*/
+float wordSolverScoreGuess(uint32_t guess, const uint32_t *answers, uint32_t answerCount);
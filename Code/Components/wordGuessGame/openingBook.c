@@ -0,0 +1,258 @@
+// Generated by Code/host/tools/gen_opening_book.c, do not edit
+// Best second guess after "raise" for each of its results
+
+#include "wordDictionary.h"
+#include "openingBook.h"
+
+const openingBook_t openingBook =
+{
+    .wordCount = 3560,
+    .answerCount = 2289,
+    .opener = 0x1102244, // raise
+    .replies =
+    {
+        0x0CA2C47, // ----- mulch
+        0x02751B3, // x---- count
+        0x0CA4C83, // +---- muted
+        0x025BA93, // -x--- clout
+        0x028BAC3, // xx--- crowd
+        0x117600B, // +x--- royal
+        0x0774D78, // -+--- hotly
+        0x025BA67, // x+--- cloth
+        0x1370C18, // ++--- today
+        0x0373693, // --x-- donut
+        0x068BA93, // x-x-- grout
+        0x117050D, // +-x-- robin
+        0x146CD0B, // -xx-- until
+        0x06581A3, // xxx-- gland
+        0x114540B, // +xx-- rival
+        0x0F03502, // -+x-- panic
+        0x0D00D11, // x+x-- nadir
+        0x015B9A3, // ++x-- blond
+        0x015D1B3, // --+-- blunt
+        0x028E1F3, // x-+-- crypt
+        0x113A1AE, // +-+-- rhino
+        0x00339B8, // -x+-- agony
+        0x000AC83, // xx+-- abled
+        DICTIONARY_INVALID_WORD, // +x+--
+        0x00181F3, // -++-- adapt
+        0x0011C83, // x++-- ached
+        0x11021B8, // +++-- rainy
+        0x0C73667, // ---x- month
+        0x02751B3, // x--x- count
+        0x11A4A78, // +--x- rusty
+        0x023816A, // -x-x- chalk
+        0x127AC13, // xx-x- splat
+        DICTIONARY_INVALID_WORD, // +x-x-
+        0x137340B, // -+-x- tonal
+        0x1204F11, // x+-x- satyr
+        0x11049F8, // ++-x- raspy
+        0x123BA93, // --xx- shout
+        0x127C506, // x-xx- sprig
+        0x1144958, // +-xx- risky
+        0x125810D, // -xxx- slain
+        0x1298111, // xxxx- stair
+        DICTIONARY_INVALID_WORD, // +xxx-
+        0x015B852, // -+xx- blocs
+        DICTIONARY_INVALID_WORD, // x+xx-
+        DICTIONARY_INVALID_WORD, // ++xx-
+        0x0A69173, // --+x- knelt
+        0x123A22A, // x-+x- shirk
+        DICTIONARY_INVALID_WORD, // +-+x-
+        DICTIONARY_INVALID_WORD, // -x+x-
+        DICTIONARY_INVALID_WORD, // xx+x-
+        DICTIONARY_INVALID_WORD, // +x+x-
+        0x12021B3, // -++x- saint
+        DICTIONARY_INVALID_WORD, // x++x-
+        DICTIONARY_INVALID_WORD, // +++x-
+        0x125B832, // ---+- slobs
+        0x02751B3, // x--+- count
+        0x1173A53, // +--+- roost
+        0x1258247, // -x-+- slash
+        0x0104C47, // xx-+- batch
+        0x1170253, // +x-+- roast
+        0x1202E72, // -+-+- salts
+        0x0704647, // x+-+- harsh
+        DICTIONARY_INVALID_WORD, // ++-+-
+        0x0C40E53, // --x+- midst
+        0x0544653, // x-x+- first
+        DICTIONARY_INVALID_WORD, // +-x+-
+        0x10A0248, // -xx+- quasi
+        DICTIONARY_INVALID_WORD, // xxx+-
+        DICTIONARY_INVALID_WORD, // +xx+-
+        DICTIONARY_INVALID_WORD, // -+x+-
+        DICTIONARY_INVALID_WORD, // x+x+-
+        DICTIONARY_INVALID_WORD, // ++x+-
+        0x0574667, // --++- forth
+        0x000804A, // x-++- aback
+        DICTIONARY_INVALID_WORD, // +-++-
+        0x0062252, // -x++- amiss
+        DICTIONARY_INVALID_WORD, // xx++-
+        DICTIONARY_INVALID_WORD, // +x++-
+        0x0302258, // -+++- daisy
+        DICTIONARY_INVALID_WORD, // x+++-
+        DICTIONARY_INVALID_WORD, // ++++-
+        0x0124C8B, // ----x betel
+        0x0324C91, // x---x deter
+        0x0275163, // +---x could
+        0x0F581B3, // -x--x plant
+        0x0159013, // xx--x bleat
+        0x0BC31E7, // +x--x lymph
+        0x0D74C47, // -+--x notch
+        0x0463E78, // x+--x empty
+        0x02046A4, // ++--x carve
+        0x0B43483, // --x-x lined
+        0x0B43483, // x-x-x lined
+        0x006CC83, // +-x-x anted
+        0x046010B, // -xx-x email
+        0x0040C91, // xxx-x aider
+        DICTIONARY_INVALID_WORD, // +xx-x
+        DICTIONARY_INVALID_WORD, // -+x-x
+        DICTIONARY_INVALID_WORD, // x+x-x
+        DICTIONARY_INVALID_WORD, // ++x-x
+        0x0323E67, // --+-x depth
+        0x03880B3, // x-+-x draft
+        0x11220CD, // +-+-x reign
+        0x005A08D, // -x+-x alien
+        DICTIONARY_INVALID_WORD, // xx+-x
+        DICTIONARY_INVALID_WORD, // +x+-x
+        DICTIONARY_INVALID_WORD, // -++-x
+        DICTIONARY_INVALID_WORD, // x++-x
+        DICTIONARY_INVALID_WORD, // +++-x
+        0x1279173, // ---xx spelt
+        0x123908F, // x--xx sheep
+        0x1120692, // +--xx rebus
+        0x0A69173, // -x-xx knelt
+        0x023818F, // xx-xx champ
+        DICTIONARY_INVALID_WORD, // +x-xx
+        0x040488B, // -+-xx easel
+        0x1201491, // x+-xx safer
+        DICTIONARY_INVALID_WORD, // ++-xx
+        0x0892C93, // --xxx islet
+        0x0C44891, // x-xxx miser
+        0x112490D, // +-xxx resin
+        0x1223D00, // -xxxx sepia
+        DICTIONARY_INVALID_WORD, // xxxxx
+        DICTIONARY_INVALID_WORD, // +xxxx
+        DICTIONARY_INVALID_WORD, // -+xxx
+        DICTIONARY_INVALID_WORD, // x+xxx
+        DICTIONARY_INVALID_WORD, // ++xxx
+        0x123A083, // --+xx shied
+        0x1252091, // x-+xx skier
+        DICTIONARY_INVALID_WORD, // +-+xx
+        DICTIONARY_INVALID_WORD, // -x+xx
+        DICTIONARY_INVALID_WORD, // xx+xx
+        DICTIONARY_INVALID_WORD, // +x+xx
+        DICTIONARY_INVALID_WORD, // -++xx
+        DICTIONARY_INVALID_WORD, // x++xx
+        DICTIONARY_INVALID_WORD, // +++xx
+        0x025B8D2, // ---+x clogs
+        0x023B9F2, // x--+x chops
+        DICTIONARY_INVALID_WORD, // +--+x
+        0x0B21678, // -x-+x lefty
+        DICTIONARY_INVALID_WORD, // xx-+x
+        DICTIONARY_INVALID_WORD, // +x-+x
+        DICTIONARY_INVALID_WORD, // -+-+x
+        DICTIONARY_INVALID_WORD, // x+-+x
+        DICTIONARY_INVALID_WORD, // ++-+x
+        DICTIONARY_INVALID_WORD, // --x+x
+        DICTIONARY_INVALID_WORD, // x-x+x
+        DICTIONARY_INVALID_WORD, // +-x+x
+        DICTIONARY_INVALID_WORD, // -xx+x
+        DICTIONARY_INVALID_WORD, // xxx+x
+        DICTIONARY_INVALID_WORD, // +xx+x
+        DICTIONARY_INVALID_WORD, // -+x+x
+        DICTIONARY_INVALID_WORD, // x+x+x
+        DICTIONARY_INVALID_WORD, // ++x+x
+        0x04BA253, // --++x exist
+        DICTIONARY_INVALID_WORD, // x-++x
+        DICTIONARY_INVALID_WORD, // +-++x
+        DICTIONARY_INVALID_WORD, // -x++x
+        DICTIONARY_INVALID_WORD, // xx++x
+        DICTIONARY_INVALID_WORD, // +x++x
+        DICTIONARY_INVALID_WORD, // -+++x
+        DICTIONARY_INVALID_WORD, // x+++x
+        DICTIONARY_INVALID_WORD, // ++++x
+        0x0275163, // ----+ could
+        0x0F8B9A6, // x---+ prong
+        0x1171A84, // +---+ rogue
+        0x0F581B3, // -x--+ plant
+        0x138804A, // xx--+ track
+        DICTIONARY_INVALID_WORD, // +x--+
+        0x06A2C47, // -+--+ gulch
+        0x000804A, // x+--+ aback
+        0x11034C4, // ++--+ range
+        0x0B434CE, // --x-+ lingo
+        0x03444C4, // x-x-+ dirge
+        0x1140CC4, // +-x-+ ridge
+        0x08600C4, // -xx-+ image
+        0x0888264, // xxx-+ irate
+        DICTIONARY_INVALID_WORD, // +xx-+
+        DICTIONARY_INVALID_WORD, // -+x-+
+        DICTIONARY_INVALID_WORD, // x+x-+
+        DICTIONARY_INVALID_WORD, // ++x-+
+        0x025BA67, // --+-+ cloth
+        0x0F00A72, // x-+-+ pacts
+        DICTIONARY_INVALID_WORD, // +-+-+
+        0x006A964, // -x+-+ ankle
+        0x002A224, // xx+-+ afire
+        DICTIONARY_INVALID_WORD, // +x+-+
+        0x0D022A4, // -++-+ naive
+        DICTIONARY_INVALID_WORD, // x++-+
+        DICTIONARY_INVALID_WORD, // +++-+
+        0x0A6BA72, // ---x+ knots
+        0x0F24447, // x--x+ perch
+        DICTIONARY_INVALID_WORD, // +--x+
+        0x025BA67, // -x-x+ cloth
+        0x02381B3, // xx-x+ chant
+        DICTIONARY_INVALID_WORD, // +x-x+
+        0x01A4C47, // -+-x+ butch
+        DICTIONARY_INVALID_WORD, // x+-x+
+        DICTIONARY_INVALID_WORD, // ++-x+
+        0x12410C4, // --xx+ siege
+        DICTIONARY_INVALID_WORD, // x-xx+
+        DICTIONARY_INVALID_WORD, // +-xx+
+        0x0044964, // -xxx+ aisle
+        DICTIONARY_INVALID_WORD, // xxxx+
+        DICTIONARY_INVALID_WORD, // +xxx+
+        DICTIONARY_INVALID_WORD, // -+xx+
+        DICTIONARY_INVALID_WORD, // x+xx+
+        DICTIONARY_INVALID_WORD, // ++xx+
+        0x0F581B3, // --+x+ plant
+        0x123A224, // x-+x+ shire
+        DICTIONARY_INVALID_WORD, // +-+x+
+        0x0092064, // -x+x+ aside
+        DICTIONARY_INVALID_WORD, // xx+x+
+        DICTIONARY_INVALID_WORD, // +x+x+
+        DICTIONARY_INVALID_WORD, // -++x+
+        DICTIONARY_INVALID_WORD, // x++x+
+        DICTIONARY_INVALID_WORD, // +++x+
+        0x025BA67, // ---++ cloth
+        0x02751B3, // x--++ count
+        0x1125244, // +--++ reuse
+        0x01A4C47, // -x-++ butch
+        0x008BA44, // xx-++ arose
+        DICTIONARY_INVALID_WORD, // +x-++
+        0x0063D64, // -+-++ ample
+        0x0F04644, // x+-++ parse
+        DICTIONARY_INVALID_WORD, // ++-++
+        DICTIONARY_INVALID_WORD, // --x++
+        DICTIONARY_INVALID_WORD, // x-x++
+        0x1143644, // +-x++ rinse
+        DICTIONARY_INVALID_WORD, // -xx++
+        DICTIONARY_INVALID_WORD, // xxx++
+        DICTIONARY_INVALID_WORD, // +xx++
+        DICTIONARY_INVALID_WORD, // -+x++
+        DICTIONARY_INVALID_WORD, // x+x++
+        DICTIONARY_INVALID_WORD, // ++x++
+        0x0D72244, // --+++ noise
+        DICTIONARY_INVALID_WORD, // x-+++
+        DICTIONARY_INVALID_WORD, // +-+++
+        DICTIONARY_INVALID_WORD, // -x+++
+        0x008A244, // xx+++ arise
+        DICTIONARY_INVALID_WORD, // +x+++
+        DICTIONARY_INVALID_WORD, // -++++
+        DICTIONARY_INVALID_WORD, // x++++
+        0x1102244, // +++++ raise
+    }
+};
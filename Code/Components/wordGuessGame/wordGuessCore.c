@@ -0,0 +1,1561 @@
+#include "esp_log.h"
+#include <string.h>
+#include <strings.h>
+#include <matrixDisplay.h>
+#include <wordDictionary.h>
+#include "guessEvaluator.h"
+#include "wordSolver.h"
+#include "wordGuessCore.h"
+
+
+/*-----------------------------------------------------------
+Literal Constants
+------------------------------------------------------------*/
+
+#define LOG_TAG "WordGuessCore"
+
+#define WORD_SIZE 6 // 5 characters + null terminator
+
+#define CAROUSEL_START_SEGMENT  1
+#define CAROUSEL_MID_SEGMENT    2
+#define CAROUSEL_END_SEGMENT    3
+#define CAROUSEL_SLIDER_INIT_STRT  ALPHABET_COUNT - 1
+#define CAROUSEL_SLIDER_INIT_MID   0
+#define CAROUSEL_SLIDER_INIT_END   1
+
+#define MAX_GUESSES 6
+
+// A guess in the history, the packed word (25 bits) then 2 bits per result (apiCharMap index)
+#define HISTORY_ROW_SIZE    5
+#define HISTORY_RESULT_BITS 2
+#define HISTORY_RESULT_MASK ((1u << HISTORY_RESULT_BITS) - 1)
+#define HISTORY_WORD_BITS   (DICTIONARY_BITS_PER_LETTER * DICTIONARY_WORD_LENGTH)
+
+// Checkpoint record: version, the date (YYYYMMDD, 4 bytes), the packed word to guess (4 bytes),
+// the number of guesses, then the history rows
+#define CHECKPOINT_VERSION      2
+#define CHECKPOINT_DATE_OFFSET  1
+#define CHECKPOINT_WORD_OFFSET  5
+#define CHECKPOINT_COUNT_OFFSET 9
+#define CHECKPOINT_HEADER_SIZE  10
+
+// When set, every locally evaluated guess is also checked against the API
+// and the API result is used if the two disagree (see Kconfig)
+#ifdef CONFIG_WORD_GUESS_REMOTE_VERIFICATION
+#define REMOTE_GUESS_VERIFICATION true
+#else
+#define REMOTE_GUESS_VERIFICATION false
+#endif
+
+#define REJECT_BLINK_COUNT 2     // Times the guess blinks when it is not in the word list
+#define REJECT_BLINK_MS    150
+
+#define MAX_BRIGHTNESS 15
+#define DEFAULT_BRIGHTNESS 2 // 0 - 15
+
+// When set, the carousal steps over letters the results showed are not in the word
+#define CAROUSEL_SKIP_ABSENT true
+
+// A held LEFT or RIGHT repeats after HOLD_FIRST_DELAY_MS, then every repeat comes
+// sooner by HOLD_SPEEDUP_NUM / HOLD_SPEEDUP_DEN until HOLD_MIN_DELAY_MS apart
+#define HOLD_FIRST_DELAY_MS 150
+#define HOLD_MIN_DELAY_MS   25
+#define HOLD_SPEEDUP_NUM    2
+#define HOLD_SPEEDUP_DEN    3
+
+#define CAROUSEL_SLIDE_MS       (HOLD_FIRST_DELAY_MS / 2)  // Until set otherwise
+#define CAROUSEL_SLIDE_FRAMES   8   // One pixel column a frame
+#define CAROUSEL_MIN_FRAME_MS   4   // Shorter slides drop frames
+
+/*-----------------------------------------------------------
+Macros
+------------------------------------------------------------*/
+
+// Bit of a letter ('a'-'z' or 'A'-'Z', or a carousal index) in the letter masks
+#define LETTER_BIT(c)   (1u << (((c) | 0x20) - 'a'))
+#define INDEX_BIT(i)    (1u << (i))
+
+/*-----------------------------------------------------------
+Types
+------------------------------------------------------------*/
+
+typedef struct
+{
+    uint8_t start;
+    uint8_t mid;
+    uint8_t end;
+}carousalSliderPos_t;
+
+typedef struct 
+{
+    char apiChar;
+    symbols_t equivalentSymbol;
+} apiCharMap_t;
+
+// Does the work for an event and returns the state to go to
+typedef wordGuessGameStates_t (*eventHandler_t)(void);
+
+typedef struct
+{
+    uint8_t leds;           // Buttons lit in the state (WORD_GUESS_LED_* bits)
+    void (*onEntry)(void);  // Run when the state is entered from another, NULL for none
+    void (*onExit)(void);   // Run when the state is left for another, NULL for none
+} gameStateInfo_t;
+
+/*-----------------------------------------------------------
+Memory Constants
+------------------------------------------------------------*/
+
+const char carousalCharacters[] = {'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 
+                                   'K', 'L', 'M', 'N', 'O', 'P', 'Q', 'R', 'S', 'T', 
+                                   'U', 'V', 'W', 'X', 'Y', 'Z'};
+
+const symbols_t carousalScreenStartState[] = {LEFT_ARROW, Z, A, B, RIGHT_ARROW};
+static_assert(CASCADE_SIZE == (sizeof(carousalScreenStartState) / sizeof(symbols_t)), "Invalid carousal start state size");
+
+const symbols_t resultsScreenStartState[] = {UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN};
+static_assert(CASCADE_SIZE == (sizeof(resultsScreenStartState) / sizeof(symbols_t)), "Invalid results start state size");
+
+const apiCharMap_t apiCharMap[] = {
+    {'+', CORRECT},
+    {'x', SWAPP_ARROWS},
+    {'-', INCORRECT},
+    {'?', UNKNOWN}      // Used when the api could not be reached
+};
+static_assert((sizeof(apiCharMap) / sizeof(apiCharMap_t)) <= HISTORY_RESULT_MASK + 1, "Results do not fit the history");
+static_assert(HISTORY_WORD_BITS + HISTORY_RESULT_BITS * CASCADE_SIZE <= HISTORY_ROW_SIZE * 8, "History rows are too small");
+static_assert(CHECKPOINT_HEADER_SIZE + MAX_GUESSES * HISTORY_ROW_SIZE <= WORD_GUESS_CHECKPOINT_MAX_SIZE, "Checkpoints do not fit WORD_GUESS_CHECKPOINT_MAX_SIZE");
+
+// GOOD \n BYE 
+const uint64_t exitScreen[] = {
+    0x3c66760606663c00,
+    0x3c66666666663c00,
+    0x3c66666666663c00,
+    0x3e66666666663e00,
+    0x0000000000000000,
+    0x0000000000000000,
+    0x3e66663e66663e00,
+    0x1818183c66666600,
+    0x7e06063e06067e00,
+    0x0000000000000000
+};
+
+/*-----------------------------------------------------------
+Gobals
+------------------------------------------------------------*/
+
+/*-----------------------------------------------------------
+Statics
+------------------------------------------------------------*/
+
+static const wordGuessBackend_t *backend = NULL;
+static uint16_t guessCount;
+static uint8_t screenBrightness = DEFAULT_BRIGHTNESS;
+static uint8_t cursorPos = 2;   // Upper display position the letter being selected goes to
+static char wordToGuess[WORD_SIZE] = {'-'};
+static char guessedWord[WORD_SIZE] = {'-'};
+static symbols_t carousalScreenState[CASCADE_SIZE];
+static symbols_t resultScreenState[CASCADE_SIZE];
+static wordGuessGameStates_t gameState = INIT;
+
+// What the results so far say about each letter, one bit per letter (A = bit 0)
+static uint32_t presentLetters = 0;    // In the word
+static uint32_t correctLetters = 0;    // In the word and placed right at least once
+static uint32_t absentLetters = 0;     // Not in the word
+static bool isSkippingAbsent = CAROUSEL_SKIP_ABSENT;
+static uint32_t slideTimeMs = CAROUSEL_SLIDE_MS;
+
+// Every guess this game and its result, packed (see saveHistoryRow)
+static uint8_t guessHistory[MAX_GUESSES][HISTORY_ROW_SIZE];
+static uint8_t historyCount = 0;
+static uint8_t historyRow = 0;      // Row showing in HISTORY
+static wordGuessGameStates_t historyReturnState = LETTER_EDIT;
+static uint64_t historySavedStates[NUM_DISPLAYS][CASCADE_SIZE];
+static bool historyCursorEnabled = false;
+static bool isCheckpointSaved = false;  // The backend holds a checkpoint of this game
+carousalSliderPos_t carousalSlider = {CAROUSEL_SLIDER_INIT_STRT, CAROUSEL_SLIDER_INIT_MID, CAROUSEL_SLIDER_INIT_END};
+
+/*-----------------------------------------------------------
+Local Function Prototypes
+------------------------------------------------------------*/
+
+/*
+* Description:
+*      Cycles the carousal in the given direction
+* 
+* Arguments:
+*     direction_t direction: The direction to cycle the carousal
+* 
+* Returns:
+*      esp_err_t: ESP_OK if the carousal was cycled successfully
+*/
+esp_err_t cycleCarousal(direction_t direction);
+
+
+/*
+* Description:
+*      Displays the carousal on the lower display
+* 
+* Arguments:
+*     None
+* 
+* Returns:
+*      esp_err_t: ESP_OK if the carousal was displayed successfully
+*/
+esp_err_t displayCarousal(void);
+
+
+/*
+* Description:
+*      Displays the results on the lower display
+* 
+* Arguments:
+*     None
+* 
+* Returns:
+*      esp_err_t: ESP_OK if the results were displayed successfully
+*/
+esp_err_t displayResults(void);
+
+/*
+* Description:
+*      Gets the next letter on the carousal in the given direction,
+*      stepping over absent letters when they are skipped
+* 
+* Arguments:
+*     uint8_t letter: Index of the letter to step from (0 - 25)
+*     direction_t direction: LEFT or RIGHT
+* 
+* Returns:
+*      uint8_t: Index of the next letter
+*/
+uint8_t nextCarousalLetter(uint8_t letter, direction_t direction);
+
+/*
+* Description:
+*      Lines the carousal up around its middle letter again, moving off the
+*      middle letter if it has been found absent since the carousal was up
+* 
+* Arguments:
+*     None
+* 
+* Returns:
+*     None
+*/
+void alignCarousal(void);
+
+/*
+* Description:
+*      Gets the line under a letter of the carousal, dotted if it is known
+*      to be in the word and solid if it has been placed right
+* 
+* Arguments:
+*     uint8_t letter: Index of the letter (0 - 25)
+* 
+* Returns:
+*      underline_t: The line
+*/
+underline_t carousalUnderline(uint8_t letter);
+
+/*
+* Description:
+*      Draws a letter of the carousal with its underline
+* 
+* Arguments:
+*     uint8_t segment: The lower display segment
+*     uint8_t letter: Index of the letter (0 - 25)
+* 
+* Returns:
+*      esp_err_t: ESP_OK if the letter was drawn successfully
+*/
+esp_err_t drawCarousalLetter(uint8_t segment, uint8_t letter);
+
+/*
+* Description:
+*      Updates the present, correct and absent letter masks from a result
+*      A '-' only rules a letter out when no other copy of it in the guess
+*      got a '+' or 'x'. Unknown results ('?') change nothing
+* 
+* Arguments:
+*     const char *guess: The guessed word
+*     const char *results: Its result ('+', 'x', '-', '?')
+* 
+* Returns:
+*     None
+*/
+void updateLetterStates(const char *guess, const char *results);
+
+/*
+* Description:
+*      Adds a guess and its result to the history, 5 bytes a guess
+* 
+* Arguments:
+*     const char *guess: The guessed word
+*     const char *results: Its result ('+', 'x', '-', '?')
+* 
+* Returns:
+*     None
+*/
+void saveHistoryRow(const char *guess, const char *results);
+
+/*
+* Description:
+*      Gets a guess and its result back from the history
+* 
+* Arguments:
+*     uint8_t row: The guess, 0 for the first
+*     char *guess: Buffer for the word (WORD_SIZE chars, lowercase)
+*     char *results: Buffer for the result (WORD_SIZE chars, '+', 'x', '-', '?'), NULL if not needed
+* 
+* Returns:
+*      True if the row is in the history
+*      False otherwise
+*/
+bool loadHistoryRow(uint8_t row, char *guess, char *results);
+
+/*
+* Description:
+*      Gets the symbol shown for a result character
+* 
+* Arguments:
+*     char result: The result ('+', 'x', '-', '?')
+* 
+* Returns:
+*      symbols_t: The symbol, UNKNOWN for anything else
+*/
+symbols_t resultToSymbol(char result);
+
+/*
+* Description:
+*      Hands a checkpoint of the game to the backend, so it can be resumed
+*      after a reset (see wordGuessCoreResume)
+* 
+* Arguments:
+*     None
+* 
+* Returns:
+*     None
+*/
+void saveCheckpoint(void);
+
+/*
+* Description:
+*      Tells the backend the checkpoint is stale (the game is over or a new
+*      one started). Nothing is sent if no checkpoint was saved
+* 
+* Arguments:
+*     None
+* 
+* Returns:
+*     None
+*/
+void clearCheckpoint(void);
+
+/*
+* Description:
+*      Draws a guess from the history on the upper display and its
+*      result on the lower display
+* 
+* Arguments:
+*     uint8_t row: The guess, 0 for the first
+* 
+* Returns:
+*      esp_err_t: ESP_OK if the row was drawn successfully
+*/
+esp_err_t drawHistoryRow(uint8_t row);
+
+/*
+* Description:
+*      Clears the board and gets a new word to guess from the backend
+*      Leaves the game state alone
+* 
+* Arguments:
+*     None
+* 
+* Returns:
+*      esp_err_t: ESP_OK if the board was reset
+*/
+esp_err_t resetGame(void);
+
+/*
+* Description:
+*      Clears the board and everything known about the game, the word to
+*      guess is left unknown
+* 
+* Arguments:
+*     None
+* 
+* Returns:
+*      esp_err_t: ESP_OK if the board was cleared
+*/
+esp_err_t clearGame(void);
+
+/*
+* Description:
+*      Moves the game to another state, running the exit action of the
+*      state it leaves and the entry action of the new one, and lights the
+*      buttons of the new state. Nothing runs if the state stays the same
+* 
+* Arguments:
+*     wordGuessGameStates_t nextState: The state to go to
+* 
+* Returns:
+*     None
+*/
+void changeState(wordGuessGameStates_t nextState);
+
+/*
+* Description:
+*      State entry and exit actions (see stateInfo)
+*      enterLetterSelection: Brings the cursor to the carousal on the lower display
+*      leaveLetterSelection: Puts the results back
+*      enterHistory: Saves both displays and shows the last guess
+*      leaveHistory: Puts both displays back as they were
+*      enterExited: Shows the exit screen with every button off
+* 
+* Arguments:
+*     None
+* 
+* Returns:
+*     None
+*/
+void enterLetterSelection(void);
+void leaveLetterSelection(void);
+void enterHistory(void);
+void leaveHistory(void);
+void enterExited(void);
+
+/*
+* Description:
+*      Event handlers, one for each (state, event) pair in transitionTable
+*      that does something. Each does the work for the event
+* 
+* Arguments:
+*     None
+* 
+* Returns:
+*      wordGuessGameStates_t: The state to go to, the same state to stay
+*/
+wordGuessGameStates_t handleStartGame(void);
+wordGuessGameStates_t handleExitGame(void);
+wordGuessGameStates_t handleBrightnessUp(void);
+wordGuessGameStates_t handleBrightnessDown(void);
+wordGuessGameStates_t handleStartSelection(void);
+wordGuessGameStates_t handleGuess(void);
+wordGuessGameStates_t handleDeleteLetter(void);
+wordGuessGameStates_t handleEditLeft(void);
+wordGuessGameStates_t handleEditRight(void);
+wordGuessGameStates_t handlePlaceLetter(void);
+wordGuessGameStates_t handleHint(void);
+wordGuessGameStates_t handleCancelSelection(void);
+wordGuessGameStates_t handleSelectionLeft(void);
+wordGuessGameStates_t handleSelectionRight(void);
+wordGuessGameStates_t handleShowHistory(void);
+wordGuessGameStates_t handleHistoryOlder(void);
+wordGuessGameStates_t handleHistoryNewer(void);
+wordGuessGameStates_t handleLeaveHistory(void);
+
+/*
+* Description:
+*      Checks that the guessed word is a real word before it is evaluated
+*      The word to guess is always accepted, even if the word list is missing it
+*      Every word is accepted if no word list is loaded
+* 
+* Arguments:
+*     None
+* 
+* Returns:
+*      True if the guess can be played
+*      False if it is incomplete or not in the word list
+*/
+bool isGuessInWordList(void);
+
+/*
+* Description:
+*      Blinks the guess on the upper display to show it was rejected
+* 
+* Arguments:
+*     None
+* 
+* Returns:
+*     None
+*/
+void rejectGuess(void);
+
+/*
+* Description:
+*      Validates the guess against the word to guess
+*      The guess is evaluated locally, the api is only called when
+*      the word to guess is unknown or CONFIG_WORD_GUESS_REMOTE_VERIFICATION is set
+*      If the guess is incorrect, the board will be updated
+* 
+* Arguments:
+*     None
+* 
+* Returns:
+*      True if the guess is correct
+*      False if the guess is incorrect
+*/
+bool validateGuess(void);
+
+/*-----------------------------------------------------------
+State Machine
+------------------------------------------------------------*/
+
+const gameStateInfo_t stateInfo[WORD_GUESS_STATE_COUNT] = {
+    [INIT]             = {WORD_GUESS_LED_SELECT | WORD_GUESS_LED_EXIT, NULL, NULL},
+    [LETTER_SELECTION] = {WORD_GUESS_LED_SELECT | WORD_GUESS_LED_GUESS | WORD_GUESS_LED_EXIT, enterLetterSelection, leaveLetterSelection},
+    [LETTER_EDIT]      = {WORD_GUESS_LED_SELECT | WORD_GUESS_LED_GUESS | WORD_GUESS_LED_DELETE | WORD_GUESS_LED_EXIT, NULL, NULL},
+    [RESULTS]          = {WORD_GUESS_LED_EXIT, NULL, NULL},
+    [HISTORY]          = {WORD_GUESS_LED_SELECT | WORD_GUESS_LED_GUESS | WORD_GUESS_LED_DELETE | WORD_GUESS_LED_EXIT, enterHistory, leaveHistory},
+    [EXITED]           = {0, enterExited, NULL}
+};
+
+// NULL where the button does nothing in the state
+const eventHandler_t transitionTable[WORD_GUESS_STATE_COUNT][WORD_GUESS_EVENT_COUNT] = {
+    [INIT] = {
+        [WORD_GUESS_EVENT_SELECT] = handleStartGame,
+        [WORD_GUESS_EVENT_EXIT]   = handleExitGame,
+        [WORD_GUESS_EVENT_UP]     = handleBrightnessUp,
+        [WORD_GUESS_EVENT_DOWN]   = handleBrightnessDown
+    },
+    [LETTER_SELECTION] = {
+        [WORD_GUESS_EVENT_SELECT] = handlePlaceLetter,
+        [WORD_GUESS_EVENT_GUESS]  = handleHint,
+        [WORD_GUESS_EVENT_EXIT]   = handleCancelSelection,
+        [WORD_GUESS_EVENT_LEFT]   = handleSelectionLeft,
+        [WORD_GUESS_EVENT_RIGHT]  = handleSelectionRight,
+        [WORD_GUESS_EVENT_UP]     = handleBrightnessUp,
+        [WORD_GUESS_EVENT_DOWN]   = handleBrightnessDown
+    },
+    [LETTER_EDIT] = {
+        [WORD_GUESS_EVENT_SELECT] = handleStartSelection,
+        [WORD_GUESS_EVENT_GUESS]  = handleGuess,
+        [WORD_GUESS_EVENT_DELETE] = handleDeleteLetter,
+        [WORD_GUESS_EVENT_EXIT]   = handleExitGame,
+        [WORD_GUESS_EVENT_LEFT]   = handleEditLeft,
+        [WORD_GUESS_EVENT_RIGHT]  = handleEditRight,
+        [WORD_GUESS_EVENT_UP]     = handleBrightnessUp,
+        [WORD_GUESS_EVENT_DOWN]   = handleBrightnessDown
+    },
+    [RESULTS] = {
+        [WORD_GUESS_EVENT_EXIT]   = handleExitGame,
+        [WORD_GUESS_EVENT_LEFT]   = handleShowHistory,
+        [WORD_GUESS_EVENT_RIGHT]  = handleShowHistory,
+        [WORD_GUESS_EVENT_UP]     = handleBrightnessUp,
+        [WORD_GUESS_EVENT_DOWN]   = handleBrightnessDown
+    },
+    [HISTORY] = {
+        [WORD_GUESS_EVENT_SELECT] = handleLeaveHistory,
+        [WORD_GUESS_EVENT_GUESS]  = handleLeaveHistory,
+        [WORD_GUESS_EVENT_DELETE] = handleLeaveHistory,
+        [WORD_GUESS_EVENT_EXIT]   = handleLeaveHistory,
+        [WORD_GUESS_EVENT_LEFT]   = handleHistoryOlder,
+        [WORD_GUESS_EVENT_RIGHT]  = handleHistoryNewer,
+        [WORD_GUESS_EVENT_UP]     = handleBrightnessUp,
+        [WORD_GUESS_EVENT_DOWN]   = handleBrightnessDown
+    },
+    // Final, the device stops handing over presses once the game is exited
+    [EXITED] = {0}
+};
+
+/*-----------------------------------------------------------
+Functions
+------------------------------------------------------------*/
+
+esp_err_t cycleCarousal(direction_t direcion)
+{
+    esp_err_t ret = ESP_OK;
+    uint8_t newLetter;
+    uint8_t frames = slideTimeMs / CAROUSEL_MIN_FRAME_MS;
+
+    if(frames > CAROUSEL_SLIDE_FRAMES)
+    {
+        frames = CAROUSEL_SLIDE_FRAMES;
+    }
+    else if(frames == 0)
+    {
+        frames = 1;
+    }
+
+    switch(direcion)
+    {
+    case LEFT:
+        // Move the carousal to the left
+        carousalSlider.end = carousalSlider.mid;
+        carousalSlider.mid = carousalSlider.start;
+        carousalSlider.start = nextCarousalLetter(carousalSlider.start, LEFT);
+        newLetter = carousalSlider.start;
+        break;
+    case RIGHT:
+        // Move the carousal to the right
+        carousalSlider.start = carousalSlider.mid;
+        carousalSlider.mid = carousalSlider.end;
+        carousalSlider.end = nextCarousalLetter(carousalSlider.end, RIGHT);
+        newLetter = carousalSlider.end;
+        break;
+    default:
+        ESP_LOGE(LOG_TAG, "Invalid direction given");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // Slide the new letter in, the letters already showing move over with it
+    ret |= slideInSymbol(charToSymbol(carousalCharacters[newLetter]), carousalUnderline(newLetter), LOWER_DISPLAY,
+                         CAROUSEL_START_SEGMENT, CAROUSEL_END_SEGMENT, direcion, frames, slideTimeMs / frames);
+
+    return ret;
+}
+
+esp_err_t displayCarousal(void)
+{
+    esp_err_t ret = ESP_OK;
+
+    disableCursor();
+
+    // Display the carousal, arrows on the ends and the letters from the slider
+    ret |= setSymbol(carousalScreenState[0], LOWER_DISPLAY, 0);
+    ret |= drawCarousalLetter(CAROUSEL_START_SEGMENT, carousalSlider.start);
+    ret |= drawCarousalLetter(CAROUSEL_MID_SEGMENT, carousalSlider.mid);
+    ret |= drawCarousalLetter(CAROUSEL_END_SEGMENT, carousalSlider.end);
+    ret |= setSymbol(carousalScreenState[CASCADE_SIZE - 1], LOWER_DISPLAY, CASCADE_SIZE - 1);
+
+    enableCursor();
+
+    return ret;
+}
+
+uint8_t nextCarousalLetter(uint8_t letter, direction_t direction)
+{
+    uint8_t step = (direction == LEFT) ? ALPHABET_COUNT - 1 : 1;
+    uint8_t next = letter;
+
+    for(uint8_t tries = 0; tries < ALPHABET_COUNT; tries++)
+    {
+        next = (next + step) % ALPHABET_COUNT;
+
+        if(!isSkippingAbsent || !(absentLetters & INDEX_BIT(next)))
+        {
+            return next;
+        }
+    }
+
+    // Every letter is out (the results don't fit any word), step as usual
+    return (letter + step) % ALPHABET_COUNT;
+}
+
+void alignCarousal(void)
+{
+    if(isSkippingAbsent && (absentLetters & INDEX_BIT(carousalSlider.mid)))
+    {
+        carousalSlider.mid = nextCarousalLetter(carousalSlider.mid, RIGHT);
+    }
+
+    carousalSlider.start = nextCarousalLetter(carousalSlider.mid, LEFT);
+    carousalSlider.end = nextCarousalLetter(carousalSlider.mid, RIGHT);
+}
+
+underline_t carousalUnderline(uint8_t letter)
+{
+    if(correctLetters & INDEX_BIT(letter))
+    {
+        return SOLID_UNDERLINE;
+    }
+    else if(presentLetters & INDEX_BIT(letter))
+    {
+        return DOTTED_UNDERLINE;
+    }
+
+    return NO_UNDERLINE;
+}
+
+esp_err_t drawCarousalLetter(uint8_t segment, uint8_t letter)
+{
+    return setUnderlinedSymbol(charToSymbol(carousalCharacters[letter]), LOWER_DISPLAY, segment, carousalUnderline(letter));
+}
+
+void updateLetterStates(const char *guess, const char *results)
+{
+    uint32_t foundLetters = 0;
+
+    for(uint8_t pos = 0; pos < GUESS_LETTER_COUNT; pos++)
+    {
+        if(results[pos] == RESULT_CORRECT)
+        {
+            correctLetters |= LETTER_BIT(guess[pos]);
+            foundLetters |= LETTER_BIT(guess[pos]);
+        }
+        else if(results[pos] == RESULT_SWAP)
+        {
+            foundLetters |= LETTER_BIT(guess[pos]);
+        }
+    }
+
+    // A '-' on a letter that also got a '+' or 'x' only means there are no more copies of it
+    for(uint8_t pos = 0; pos < GUESS_LETTER_COUNT; pos++)
+    {
+        if(results[pos] == RESULT_WRONG && !(foundLetters & LETTER_BIT(guess[pos])))
+        {
+            absentLetters |= LETTER_BIT(guess[pos]);
+        }
+    }
+
+    presentLetters |= foundLetters;
+    absentLetters &= ~presentLetters;
+}
+
+void saveHistoryRow(const char *guess, const char *results)
+{
+    uint64_t packed = wordDictionaryPack(guess);
+    uint8_t resultIndex;
+
+    if(historyCount >= MAX_GUESSES || packed == DICTIONARY_INVALID_WORD)
+    {
+        ESP_LOGW(LOG_TAG, "Guess not kept in the history");
+        return;
+    }
+
+    for(uint8_t pos = 0; pos < CASCADE_SIZE; pos++)
+    {
+        // Anything not in the map is kept as unknown, the last entry
+        for(resultIndex = 0; resultIndex < (sizeof(apiCharMap) / sizeof(apiCharMap_t)) - 1; resultIndex++)
+        {
+            if(results[pos] == apiCharMap[resultIndex].apiChar)
+            {
+                break;
+            }
+        }
+
+        packed |= (uint64_t)resultIndex << (HISTORY_WORD_BITS + pos * HISTORY_RESULT_BITS);
+    }
+
+    for(uint8_t byte = 0; byte < HISTORY_ROW_SIZE; byte++)
+    {
+        guessHistory[historyCount][byte] = packed >> (byte * 8);
+    }
+
+    historyCount++;
+}
+
+bool loadHistoryRow(uint8_t row, char *guess, char *results)
+{
+    uint64_t packed = 0;
+
+    if(row >= historyCount)
+    {
+        return false;
+    }
+
+    for(uint8_t byte = 0; byte < HISTORY_ROW_SIZE; byte++)
+    {
+        packed |= (uint64_t)guessHistory[row][byte] << (byte * 8);
+    }
+
+    wordDictionaryUnpack(packed & ((1u << HISTORY_WORD_BITS) - 1), guess);
+
+    for(uint8_t pos = 0; results != NULL && pos < CASCADE_SIZE; pos++)
+    {
+        results[pos] = apiCharMap[(packed >> (HISTORY_WORD_BITS + pos * HISTORY_RESULT_BITS)) & HISTORY_RESULT_MASK].apiChar;
+    }
+
+    if(results != NULL)
+    {
+        results[CASCADE_SIZE] = '\0';
+    }
+
+    return true;
+}
+
+symbols_t resultToSymbol(char result)
+{
+    for(uint8_t character = 0; character < sizeof(apiCharMap) / sizeof(apiCharMap_t); character++)
+    {
+        if(result == apiCharMap[character].apiChar)
+        {
+            return apiCharMap[character].equivalentSymbol;
+        }
+    }
+
+    return UNKNOWN;
+}
+
+void saveCheckpoint(void)
+{
+    uint8_t record[WORD_GUESS_CHECKPOINT_MAX_SIZE];
+    uint32_t packedWord = wordDictionaryPack(wordToGuess);
+    uint32_t date = 0;
+
+    // Saved without a date if the clock is not set yet
+    if(!backend->getDate(&date))
+    {
+        date = 0;
+    }
+
+    record[0] = CHECKPOINT_VERSION;
+
+    for(uint8_t byte = 0; byte < sizeof(date); byte++)
+    {
+        record[CHECKPOINT_DATE_OFFSET + byte] = date >> (byte * 8);
+    }
+
+    for(uint8_t byte = 0; byte < sizeof(packedWord); byte++)
+    {
+        record[CHECKPOINT_WORD_OFFSET + byte] = packedWord >> (byte * 8);
+    }
+
+    record[CHECKPOINT_COUNT_OFFSET] = historyCount;
+    memcpy(&record[CHECKPOINT_HEADER_SIZE], guessHistory, historyCount * HISTORY_ROW_SIZE);
+
+    backend->saveGame(record, CHECKPOINT_HEADER_SIZE + historyCount * HISTORY_ROW_SIZE);
+    isCheckpointSaved = true;
+}
+
+void clearCheckpoint(void)
+{
+    if(isCheckpointSaved)
+    {
+        backend->saveGame(NULL, 0);
+        isCheckpointSaved = false;
+    }
+}
+
+esp_err_t drawHistoryRow(uint8_t row)
+{
+    esp_err_t ret = ESP_OK;
+    char guess[WORD_SIZE];
+    char results[WORD_SIZE];
+
+    if(!loadHistoryRow(row, guess, results))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    for(uint8_t segment = 0; segment < CASCADE_SIZE; segment++)
+    {
+        ret |= setSymbol(charToSymbol(guess[segment]), UPPER_DISPLAY, segment);
+        ret |= setSymbol(resultToSymbol(results[segment]), LOWER_DISPLAY, segment);
+    }
+
+    ESP_LOGI(LOG_TAG, "Guess %d of %d: %s", row + 1, historyCount, guess);
+
+    return ret;
+}
+
+void wordGuessCoreSkipAbsentLetters(bool isSkipping)
+{
+    isSkippingAbsent = isSkipping;
+}
+
+uint32_t wordGuessCoreHoldDelay(uint16_t repeats)
+{
+    uint32_t delayMs = HOLD_FIRST_DELAY_MS;
+
+    for(uint16_t repeat = 0; repeat < repeats && delayMs > HOLD_MIN_DELAY_MS; repeat++)
+    {
+        delayMs = delayMs * HOLD_SPEEDUP_NUM / HOLD_SPEEDUP_DEN;
+    }
+
+    return (delayMs < HOLD_MIN_DELAY_MS) ? HOLD_MIN_DELAY_MS : delayMs;
+}
+
+void wordGuessCoreSetSlideTime(uint32_t slideMs)
+{
+    slideTimeMs = slideMs;
+}
+
+esp_err_t displayResults(void)
+{
+    esp_err_t ret = ESP_OK;
+
+    // Display the results
+    for(uint8_t segment = 0; segment < CASCADE_SIZE; segment++)
+    {
+        ret |= setSymbol(resultScreenState[segment], LOWER_DISPLAY, segment);
+    }
+
+    return ret;
+}
+
+void wordGuessCoreChangeBrightness(direction_t direction)
+{
+    if(direction == UP)
+    {
+        if(++screenBrightness > MAX_BRIGHTNESS)
+        {
+            screenBrightness = MAX_BRIGHTNESS;
+        }
+    }
+    else
+    {
+        if(--screenBrightness > MAX_BRIGHTNESS)
+        {
+            screenBrightness = 0;
+        }
+    }
+
+    setBrightness(screenBrightness);
+    ESP_LOGI(LOG_TAG, "Brightness: %d", screenBrightness);
+}
+
+void changeState(wordGuessGameStates_t nextState)
+{
+    if(nextState == gameState)
+    {
+        return;
+    }
+
+    if(stateInfo[gameState].onExit != NULL)
+    {
+        stateInfo[gameState].onExit();
+    }
+
+    gameState = nextState;
+
+    backend->setButtonLeds(stateInfo[gameState].leds);
+
+    if(stateInfo[gameState].onEntry != NULL)
+    {
+        stateInfo[gameState].onEntry();
+    }
+}
+
+void enterLetterSelection(void)
+{
+    // Get cursor position
+    cursorPos = getCursorPos();
+
+    // Get the cursor to the center
+    moveCursorMultiple(RIGHT, (2 - cursorPos + CASCADE_SIZE) % CASCADE_SIZE);
+
+    // Letters may have been ruled out since the carousal was last up
+    alignCarousal();
+
+    displayCarousal();
+
+    moveCursor(DOWN);
+}
+
+void leaveLetterSelection(void)
+{
+    // Display the result screen
+    displayResults();
+
+    // Reset the cursor
+    resetCursor();
+}
+
+void enterHistory(void)
+{
+    // Kept as is, so leaving puts the board back in one go
+    getDisplayState(UPPER_DISPLAY, historySavedStates[UPPER_DISPLAY]);
+    getDisplayState(LOWER_DISPLAY, historySavedStates[LOWER_DISPLAY]);
+
+    historyCursorEnabled = isCursorEnabled();
+
+    if(historyCursorEnabled)
+    {
+        disableCursor();
+    }
+
+    historyRow = historyCount - 1;
+    drawHistoryRow(historyRow);
+}
+
+void leaveHistory(void)
+{
+    // The saved graphics have the cursor drawn in
+    setDisplayState(UPPER_DISPLAY, historySavedStates[UPPER_DISPLAY]);
+    setDisplayState(LOWER_DISPLAY, historySavedStates[LOWER_DISPLAY]);
+
+    if(historyCursorEnabled)
+    {
+        enableCursor();
+    }
+}
+
+void enterExited(void)
+{
+    ESP_LOGI(LOG_TAG, "Exiting word guess game");
+
+    // Left for good, there is nothing to come back to after a reset
+    clearCheckpoint();
+
+    displayFullGraphic(exitScreen, sizeof(exitScreen));
+}
+
+esp_err_t wordGuessCoreInit(const wordGuessBackend_t *newBackend)
+{
+    if(newBackend == NULL || newBackend->setButtonLeds == NULL || newBackend->getWordToGuess == NULL ||
+       newBackend->checkGuess == NULL || newBackend->showHint == NULL || newBackend->delayMs == NULL ||
+       newBackend->getDate == NULL || newBackend->saveGame == NULL)
+    {
+        ESP_LOGE(LOG_TAG, "Incomplete backend");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    backend = newBackend;
+    gameState = INIT;
+
+    backend->setButtonLeds(stateInfo[gameState].leds);
+
+    return ESP_OK;
+}
+
+esp_err_t wordGuessCoreReset(void)
+{
+    esp_err_t ret = resetGame();
+
+    // The board is new, nothing to leave
+    gameState = INIT;
+
+    backend->setButtonLeds(stateInfo[gameState].leds);
+
+    return ret;
+}
+
+esp_err_t resetGame(void)
+{
+    esp_err_t ret = ESP_OK;
+
+    ESP_LOGI(LOG_TAG, "Reseting word guess game");
+
+    // A new game, the last one can't be resumed anymore
+    clearCheckpoint();
+
+    ret |= clearGame();
+
+    // Retreive the word to guess, left unknown if there is none
+    if(!backend->getWordToGuess(wordToGuess, WORD_SIZE))
+    {
+        memset(wordToGuess, '-', sizeof(wordToGuess));
+        wordToGuess[WORD_SIZE - 1] = '\0';
+
+        ESP_LOGE(LOG_TAG, "Failed to retrieve the word to guess");
+    }
+    ESP_LOGI(LOG_TAG, "Word to guess: %s", wordToGuess);
+
+    return ret;
+}
+
+esp_err_t clearGame(void)
+{
+    esp_err_t ret = ESP_OK;
+
+    // Reset the carousal
+    memcpy(carousalScreenState, carousalScreenStartState, sizeof(carousalScreenState));
+
+    // Reset the carousal slider
+    carousalSlider.start = CAROUSEL_SLIDER_INIT_STRT;
+    carousalSlider.mid = CAROUSEL_SLIDER_INIT_MID;
+    carousalSlider.end = CAROUSEL_SLIDER_INIT_END;
+
+    // Reset the results
+    memcpy(resultScreenState, resultsScreenStartState, sizeof(resultScreenState));
+
+    // No guesses yet
+    historyCount = 0;
+
+    // Nothing is known about any letter
+    presentLetters = 0;
+    correctLetters = 0;
+    absentLetters = 0;
+
+    // Reset the board
+    disableCursor();
+    ret |= resetBoard();
+    enableCursor();
+
+    // Reset brightness
+    screenBrightness = DEFAULT_BRIGHTNESS;
+    setBrightness(screenBrightness);
+
+    // Reset the wordToGuess 
+    memset(wordToGuess, '-', sizeof(wordToGuess));
+    wordToGuess[WORD_SIZE - 1] = '\0';
+
+    // Reset the guessedWord
+    memset(guessedWord, '-', sizeof(guessedWord));
+    guessedWord[WORD_SIZE - 1] = '\0';
+
+    // Reset the guess count
+    guessCount = 0;
+
+    // Every answer is possible again
+    wordSolverReset();
+
+    return ret;
+}
+
+esp_err_t wordGuessCoreResume(const void *record, size_t size)
+{
+    esp_err_t ret = ESP_OK;
+    const uint8_t *bytes = record;
+    uint32_t packedWord = 0;
+    uint8_t count;
+    char guess[WORD_SIZE];
+    char results[WORD_SIZE];
+
+    if(backend == NULL || bytes == NULL || size < CHECKPOINT_HEADER_SIZE || bytes[0] != CHECKPOINT_VERSION)
+    {
+        ESP_LOGW(LOG_TAG, "Not a checkpoint");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // A game over is never saved, so there is at least one guess left
+    count = bytes[CHECKPOINT_COUNT_OFFSET];
+
+    if(count == 0 || count >= MAX_GUESSES || size != (size_t)(CHECKPOINT_HEADER_SIZE + count * HISTORY_ROW_SIZE))
+    {
+        ESP_LOGW(LOG_TAG, "Checkpoint of %d guesses has the wrong size", count);
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    for(uint8_t byte = 0; byte < sizeof(packedWord); byte++)
+    {
+        packedWord |= (uint32_t)bytes[CHECKPOINT_WORD_OFFSET + byte] << (byte * 8);
+    }
+
+    ret |= clearGame();
+
+    // Unknown if the results came from the api, they still will
+    if(packedWord != DICTIONARY_INVALID_WORD)
+    {
+        wordDictionaryUnpack(packedWord, wordToGuess);
+    }
+
+    // Play the results back into the solver and the letter marks, nothing goes to the api
+    memcpy(guessHistory, &bytes[CHECKPOINT_HEADER_SIZE], count * HISTORY_ROW_SIZE);
+    historyCount = count;
+
+    for(uint8_t row = 0; row < count; row++)
+    {
+        loadHistoryRow(row, guess, results);
+        wordSolverApply(guess, results);
+        updateLetterStates(guess, results);
+    }
+
+    guessCount = count;
+
+    // The board as it was left after the last guess
+    for(uint8_t segment = 0; segment < CASCADE_SIZE; segment++)
+    {
+        resultScreenState[segment] = resultToSymbol(results[segment]);
+    }
+
+    // The cleared board has the cursor in its start spot on the upper display
+    for(uint8_t segment = 0; segment < CASCADE_SIZE; segment++)
+    {
+        ret |= setSymbol(charToSymbol(guess[segment]), UPPER_DISPLAY, segment);
+    }
+
+    disableCursor();
+
+    ret |= displayResults();
+
+    enableCursor();
+
+    isCheckpointSaved = true;
+    gameState = LETTER_EDIT;
+
+    backend->setButtonLeds(stateInfo[gameState].leds);
+
+    ESP_LOGI(LOG_TAG, "Resumed at guess %d of %d", guessCount + 1, MAX_GUESSES);
+
+    return ret;
+}
+
+uint32_t wordGuessCoreCheckpointDate(const void *record, size_t size)
+{
+    const uint8_t *bytes = record;
+    uint32_t date = 0;
+
+    if(bytes == NULL || size < CHECKPOINT_HEADER_SIZE || bytes[0] != CHECKPOINT_VERSION)
+    {
+        return 0;
+    }
+
+    for(uint8_t byte = 0; byte < sizeof(date); byte++)
+    {
+        date |= (uint32_t)bytes[CHECKPOINT_DATE_OFFSET + byte] << (byte * 8);
+    }
+
+    return date;
+}
+
+wordGuessGameStates_t wordGuessCoreGetState(void)
+{
+    return gameState;
+}
+
+uint16_t wordGuessCoreGetGuessCount(void)
+{
+    return guessCount;
+}
+
+bool wordGuessCoreHandleEvent(wordGuessEvent_t event)
+{
+    eventHandler_t handler;
+
+    if(event >= WORD_GUESS_EVENT_COUNT || gameState >= WORD_GUESS_STATE_COUNT)
+    {
+        ESP_LOGE(LOG_TAG, "Given invalid event or game state");
+        return gameState != EXITED;
+    }
+
+    handler = transitionTable[gameState][event];
+
+    if(handler != NULL)
+    {
+        changeState(handler());
+    }
+
+    return gameState != EXITED;
+}
+
+wordGuessGameStates_t handleStartGame(void)
+{
+    resetGame();
+
+    return LETTER_EDIT;
+}
+
+wordGuessGameStates_t handleExitGame(void)
+{
+    return EXITED;
+}
+
+wordGuessGameStates_t handleBrightnessUp(void)
+{
+    wordGuessCoreChangeBrightness(UP);
+
+    return gameState;
+}
+
+wordGuessGameStates_t handleBrightnessDown(void)
+{
+    wordGuessCoreChangeBrightness(DOWN);
+
+    return gameState;
+}
+
+wordGuessGameStates_t handleStartSelection(void)
+{
+    return LETTER_SELECTION;
+}
+
+wordGuessGameStates_t handleGuess(void)
+{
+    wordGuessGameStates_t nextState = LETTER_EDIT;
+
+    char lastGuess[WORD_SIZE];
+    char lastResults[WORD_SIZE];
+
+    getWord(guessedWord, sizeof(guessedWord));
+
+    // An empty row, or the last guess again, shows the earlier guesses instead of using one up
+    // Not when the api could not score the last guess ('?'), then it is played again
+    if(historyCount > 0 && (strspn(guessedWord, "-") == CASCADE_SIZE ||
+       (loadHistoryRow(historyCount - 1, lastGuess, lastResults) && strncasecmp(guessedWord, lastGuess, CASCADE_SIZE) == 0 &&
+        memchr(lastResults, '?', CASCADE_SIZE) == NULL)))
+    {
+        return handleShowHistory();
+    }
+
+    ESP_LOGI(LOG_TAG, "Word guessed is: %s", guessedWord);
+
+    // Reject non-words before they cost a guess or an api call
+    if(!isGuessInWordList())
+    {
+        ESP_LOGI(LOG_TAG, "Word guessed is not in the word list");
+
+        rejectGuess();
+        return LETTER_EDIT;
+    }
+
+    if(validateGuess())
+    {
+        ESP_LOGI(LOG_TAG, "Word guessed is correct");
+
+        nextState = RESULTS;
+    }
+    else
+    {
+        ESP_LOGI(LOG_TAG, "Word guessed is incorrect");
+
+        ++guessCount;
+
+        if(guessCount >= MAX_GUESSES)
+        {
+            // Set the results screen to the word to guess
+            for(uint8_t segment = 0; segment < CASCADE_SIZE; segment++)
+            {
+                resultScreenState[segment] = charToSymbol(wordToGuess[segment]);
+            }
+
+            ESP_LOG_BUFFER_HEXDUMP(LOG_TAG, wordToGuess, WORD_SIZE, ESP_LOG_DEBUG);
+            ESP_LOGI(LOG_TAG, "------");
+            ESP_LOG_BUFFER_HEXDUMP(LOG_TAG, resultScreenState, CASCADE_SIZE, ESP_LOG_DEBUG);
+
+            nextState = RESULTS;
+        }
+        else
+        {
+            ESP_LOGI(LOG_TAG, "Guesses left: %d", MAX_GUESSES - guessCount);
+        }
+    }
+
+    // Keep the game through a reset until it is over
+    if(nextState == RESULTS)
+    {
+        clearCheckpoint();
+    }
+    else
+    {
+        saveCheckpoint();
+    }
+
+    disableCursor();
+
+    displayResults();
+
+    enableCursor();
+
+    resetCursor();
+
+    return nextState;
+}
+
+wordGuessGameStates_t handleDeleteLetter(void)
+{
+    // Get cursor position
+    cursorPos = getCursorPos();
+
+    setSymbol(charToSymbol('-'), UPPER_DISPLAY, cursorPos);
+
+    return LETTER_EDIT;
+}
+
+wordGuessGameStates_t handleEditLeft(void)
+{
+    moveCursor(LEFT);
+
+    return LETTER_EDIT;
+}
+
+wordGuessGameStates_t handleEditRight(void)
+{
+    moveCursor(RIGHT);
+
+    return LETTER_EDIT;
+}
+
+wordGuessGameStates_t handlePlaceLetter(void)
+{
+    // Convert the selected character to a symbol
+    symbols_t convertedChar = charToSymbol(getCharAtCursor());
+
+    // Make sure the character is valid
+    if(convertedChar == INVALID_SYMBOL)
+    {
+        ESP_LOGE(LOG_TAG, "Invalid character selected");
+        return LETTER_SELECTION;
+    }
+
+    // Disable the cursor 
+    // This is as a fix for a bug that I dont have time to fix
+    disableCursor();
+
+    // Set the character on the display
+    setSymbol(convertedChar, UPPER_DISPLAY, cursorPos);
+    
+    // Re-enable the cursor
+    enableCursor();
+
+    // Leaving the selection puts the results back
+    return LETTER_EDIT;
+}
+
+wordGuessGameStates_t handleHint(void)
+{
+    // Hint, how many answers are still possible and the best next guess
+    backend->showHint();
+
+    return LETTER_SELECTION;
+}
+
+wordGuessGameStates_t handleCancelSelection(void)
+{
+    return LETTER_EDIT;
+}
+
+wordGuessGameStates_t handleSelectionLeft(void)
+{
+    if(getCursorPos() == CAROUSEL_START_SEGMENT)
+    {
+        // Move the carousal to the left
+        cycleCarousal(LEFT);
+    }
+    else
+    {
+        // Move the cursor to the left
+        moveCursor(LEFT);
+    }
+
+    return LETTER_SELECTION;
+}
+
+wordGuessGameStates_t handleSelectionRight(void)
+{
+    if(getCursorPos() == CAROUSEL_END_SEGMENT)
+    {
+        // Move the carousal to the right
+        cycleCarousal(RIGHT);
+    }
+    else
+    {
+        // Move the cursor to the right
+        moveCursor(RIGHT);
+    }
+
+    return LETTER_SELECTION;
+}
+
+wordGuessGameStates_t handleShowHistory(void)
+{
+    if(historyCount == 0)
+    {
+        return gameState;
+    }
+
+    historyReturnState = gameState;
+
+    return HISTORY;
+}
+
+wordGuessGameStates_t handleHistoryOlder(void)
+{
+    if(historyRow > 0)
+    {
+        drawHistoryRow(--historyRow);
+    }
+
+    return HISTORY;
+}
+
+wordGuessGameStates_t handleHistoryNewer(void)
+{
+    // Past the last guess is the board again
+    if(historyRow + 1 >= historyCount)
+    {
+        return historyReturnState;
+    }
+
+    drawHistoryRow(++historyRow);
+
+    return HISTORY;
+}
+
+wordGuessGameStates_t handleLeaveHistory(void)
+{
+    return historyReturnState;
+}
+
+bool isGuessInWordList(void)
+{
+    if(!isWordComplete(guessedWord))
+    {
+        return false;
+    }
+
+    if(isWordComplete(wordToGuess) && strncasecmp(guessedWord, wordToGuess, CASCADE_SIZE) == 0)
+    {
+        return true;
+    }
+
+    // Without a word list (e.g. the dict partition was not flashed) every word is allowed
+    return !wordDictionaryIsLoaded() || wordDictionaryContains(guessedWord);
+}
+
+void rejectGuess(void)
+{
+    uint64_t savedState[CASCADE_SIZE];
+    bool cursorEnabled = isCursorEnabled();
+
+    getDisplayState(UPPER_DISPLAY, savedState);
+
+    if(cursorEnabled)
+    {
+        disableCursor();
+    }
+
+    for(uint8_t blink = 0; blink < REJECT_BLINK_COUNT; blink++)
+    {
+        clearDisplay(UPPER_DISPLAY);
+        backend->delayMs(REJECT_BLINK_MS);
+
+        setDisplayState(UPPER_DISPLAY, savedState);
+        backend->delayMs(REJECT_BLINK_MS);
+    }
+
+    if(cursorEnabled)
+    {
+        enableCursor();
+    }
+}
+
+bool validateGuess(void)
+{
+    bool isCorrect = true;
+    char guessResults[WORD_SIZE];
+    char localResults[WORD_SIZE];
+    bool haveLocalResults = isWordComplete(wordToGuess);
+
+    // Evaluate locally, only fall back to the API when we don't have the word
+    if(haveLocalResults)
+    {
+        evaluateGuess(guessedWord, wordToGuess, localResults);
+        memcpy(guessResults, localResults, WORD_SIZE);
+    }
+
+    if(!haveLocalResults || REMOTE_GUESS_VERIFICATION)
+    {
+        if(!backend->checkGuess(guessedWord, guessResults, WORD_SIZE))
+        {
+            // Keep the local result if there is one, otherwise the result is unknown
+            if(haveLocalResults)
+            {
+                memcpy(guessResults, localResults, WORD_SIZE);
+            }
+            else
+            {
+                memset(guessResults, '?', CASCADE_SIZE);
+                guessResults[CASCADE_SIZE] = '\0';
+            }
+        }
+        else if(haveLocalResults && strncmp(guessResults, localResults, CASCADE_SIZE) != 0)
+        {
+            ESP_LOGW(LOG_TAG, "Local result %s does not match API result %s", localResults, guessResults);
+        }
+    }
+    // memcpy(guessResults, "++--x", WORD_SIZE);
+    // memcpy(guessResults, "+++++", WORD_SIZE);
+
+    // Narrow down the answers that are left, unknown results are skipped
+    wordSolverApply(guessedWord, guessResults);
+    updateLetterStates(guessedWord, guessResults);
+    saveHistoryRow(guessedWord, guessResults);
+
+    // Set the results
+    for(uint8_t segment = 0; segment < CASCADE_SIZE; segment++)
+    {   
+        // Get the equivalent symbol for the character
+        resultScreenState[segment] = resultToSymbol(guessResults[segment]);
+
+        // Flip the is correct flag if at least one character is incorrect
+        if( isCorrect && resultScreenState[segment] != CORRECT)
+        {
+            isCorrect = false;
+        }
+    }
+
+    return isCorrect;
+ }
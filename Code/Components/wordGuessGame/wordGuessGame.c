@@ -1,9 +1,17 @@
 #include "esp_log.h"
 #include <string.h>
 #include <ctype.h>
+#include "esp_timer.h"
 #include <matrixDisplay.h>
 #include <gpioControl.h>
-#include <api_client.h>
+#include <api_request.h>
+#include "guessEvaluator.h"
+#include "dailyWord.h"
+#include "wordSolver.h"
+#include "wordHint.h"
+#include "gameCheckpoint.h"
+#include "wifi.h"
+#include "wordGuessCore.h"
 #include "wordGuessGame.h"
 
 
@@ -25,814 +33,608 @@ Literal Constants
 #define EXIT_BTN        GPIO_BTN_D      //J14 Header (RED)
 #define EXIT_BTN_LED    GPIO_BTN_D_LED
 
-#define CAROUSEL_START_SEGMENT  1
-#define CAROUSEL_MID_SEGMENT    2
-#define CAROUSEL_END_SEGMENT    3
-#define CAROUSEL_SLIDER_INIT_STRT  ALPHABET_COUNT - 1
-#define CAROUSEL_SLIDER_INIT_MID   0
-#define CAROUSEL_SLIDER_INIT_END   1
+#define API_DEADLINE_MS 10000   // Give up on an api request after this long
+#define BUSY_FRAME_MS   100     // Busy indicator frame time while waiting on the api
 
-#define BTN_HOLD_DELAY_MS 150 //200
-
-#define MAX_GUESSES 6
-
-#define MAX_BRIGHTNESS 15
-#define DEFAULT_BRIGHTNESS 2 // 0 - 15
-
-/*-----------------------------------------------------------
-Types
-------------------------------------------------------------*/
-
-typedef enum 
-{
-    INIT,
-    LETTER_SELECTION,
-    LETTER_EDIT,
-    RESULTS
-} wordGuessGameStates_t;
-
-typedef struct
-{
-    uint8_t start;
-    uint8_t mid;
-    uint8_t end;
-}carousalSliderPos_t;
-
-typedef struct 
-{
-    char apiChar;
-    symbols_t equivalentSymbol;
-} apiCharMap_t;
+#define CANDIDATES_SHOW_MS 2000  // How long the candidates left stay up, any button clears them sooner
+#define HINT_SHOW_MS       4000  // How long a suggested guess stays up, any button clears it sooner
 
 /*-----------------------------------------------------------
-Memory Constants
+Local Function Prototypes
 ------------------------------------------------------------*/
 
-const char carousalCharacters[] = {'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 
-                                   'K', 'L', 'M', 'N', 'O', 'P', 'Q', 'R', 'S', 'T', 
-                                   'U', 'V', 'W', 'X', 'Y', 'Z'};
-
-const symbols_t carousalScreenStartState[] = {LEFT_ARROW, Z, A, B, RIGHT_ARROW};
-static_assert(CASCADE_SIZE == (sizeof(carousalScreenStartState) / sizeof(symbols_t)), "Invalid carousal start state size");
-
-const symbols_t resultsScreenStartState[] = {UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN};
-static_assert(CASCADE_SIZE == (sizeof(resultsScreenStartState) / sizeof(symbols_t)), "Invalid results start state size");
-
-const apiCharMap_t apiCharMap[] = {
-    {'+', CORRECT},
-    {'x', SWAPP_ARROWS},
-    {'-', INCORRECT}
-};
-
-// GOOD \n BYE 
-const uint64_t exitScreen[] = {
-    0x3c66760606663c00,
-    0x3c66666666663c00,
-    0x3c66666666663c00,
-    0x3e66666666663e00,
-    0x0000000000000000,
-    0x0000000000000000,
-    0x3e66663e66663e00,
-    0x1818183c66666600,
-    0x7e06063e06067e00,
-    0x0000000000000000
-};
-
-/*-----------------------------------------------------------
-Gobals
-------------------------------------------------------------*/
+/*
+* Description:
+*      Waits for an api request to finish while keeping the console responsive
+*      A busy indicator runs on the lower display, the brightness buttons keep
+*      working and EXIT cancels the request. Other presses are put back in the
+*      queue in order once the wait is over, for the game to handle
+*      The request is cancelled if it takes longer than API_DEADLINE_MS
+* 
+* Arguments:
+*     api_request_handle_t request: The request to wait on (released by this function)
+*     char *result: Buffer for the result of the request
+*     int resultSize: The size of the buffer
+* 
+* Returns:
+*      True if the request finished and the result was copied
+*      False if it failed, timed out or was cancelled
+*/
+bool waitForApiRequest(api_request_handle_t request, char *result, int resultSize);
 
-/*-----------------------------------------------------------
-Statics
-------------------------------------------------------------*/
+/*
+* Description:
+*      Sets word to all lowercase
+* 
+* Arguments:
+*     char *str: The string to convert to lowercase (needs to be null terminated)
+* 
+* Returns:
+*     None
+*/
+void toLowercase(char *str);
 
-static uint16_t guessCount;
-static uint8_t screenBrightness = DEFAULT_BRIGHTNESS;
-static char wordToGuess[WORD_SIZE] = {'-'};
-static char guessedWord[WORD_SIZE] = {'-'};
-static symbols_t carousalScreenState[CASCADE_SIZE];
-static symbols_t resultScreenState[CASCADE_SIZE];
-static wordGuessGameStates_t gameState = INIT;
-carousalSliderPos_t carousalSlider = {CAROUSEL_SLIDER_INIT_STRT, CAROUSEL_SLIDER_INIT_MID, CAROUSEL_SLIDER_INIT_END};
+/*
+* Description:
+*      Maps a button to the game event it sends
+* 
+* Arguments:
+*     uint32_t ioNum: The GPIO number of the button
+*     wordGuessEvent_t *event: Where to store the event
+* 
+* Returns:
+*      True if the button sends an event
+*      False otherwise
+*/
+bool buttonToEvent(uint32_t ioNum, wordGuessEvent_t *event);
 
-/*-----------------------------------------------------------
-Local Function Prototypes
-------------------------------------------------------------*/
+/*
+* Description:
+*      Lights the action button LEDs (backend for the game)
+* 
+* Arguments:
+*     uint8_t leds: WORD_GUESS_LED_* bits of the buttons to light
+* 
+* Returns:
+*     None
+*/
+void setButtonLeds(uint8_t leds);
 
 /*
 * Description:
-*      Cycles the carousal in the given direction
+*      Gets today's word from the NVS cache, the api (prefetched at boot if
+*      possible) or, when the api cannot be reached, the offline answer list
+*      (backend for the game)
 * 
 * Arguments:
-*     direction_t direction: The direction to cycle the carousal
+*     char *word: Buffer for the word (6 chars, null terminated)
+*     int wordSize: The size of the buffer
 * 
 * Returns:
-*      esp_err_t: ESP_OK if the carousal was cycled successfully
+*      True if there is a word
+*      False if none of them had one
 */
-esp_err_t cycleCarousal(direction_t direction);
+bool getWordToGuess(char *word, int wordSize);
 
+/*
+* Description:
+*      Gets the result of a guess from the api (backend for the game)
+* 
+* Arguments:
+*     const char *guess: The guessed word
+*     char *result: Buffer for the result
+*     int resultSize: The size of the buffer
+* 
+* Returns:
+*      True if the api answered
+*      False if it failed, timed out or was cancelled
+*/
+bool checkGuess(const char *guess, char *result, int resultSize);
 
 /*
 * Description:
-*      Displays the carousal on the lower display
+*      Shows the number of answers that still fit every result so far
+*      on the lower display, until a button is pressed or CANDIDATES_SHOW_MS
+*      has passed, then puts the display back
+*      Pressing GUESS while the number is up shows the best next guess
 * 
 * Arguments:
 *     None
 * 
 * Returns:
-*      esp_err_t: ESP_OK if the carousal was displayed successfully
+*     None
 */
-esp_err_t displayCarousal(void);
-
+void showHint(void);
 
 /*
 * Description:
-*      Displays the results on the lower display
+*      Runs while the best guess is being searched for
+*      Steps the busy indicator on the lower display
 * 
 * Arguments:
 *     None
 * 
 * Returns:
-*      esp_err_t: ESP_OK if the results were displayed successfully
+*      True if a button was pressed and the search should stop
+*      False to keep searching
 */
-esp_err_t displayResults(void);
+bool hintProgress(void);
 
 /*
 * Description:
-*      Sets word to all lowercase
+*      Blocks the game task (backend for the game)
 * 
 * Arguments:
-*     char *str: The string to convert to lowercase (needs to be null terminated)
+*     uint32_t ms: How long to wait
 * 
 * Returns:
 *     None
 */
-void toLowercase(char *str);
+void delayMs(uint32_t ms);
 
 /*
 * Description:
-*      Calls the api and validates the guess
-*      If the guess is incorrect, the board will be updated
+*      Gets the game checkpoint kept in NVS, if it is from today
+*      A checkpoint from another day is cleared, that day's word is over
+*      One saved without a date, or read while the date is not known, is kept
 * 
 * Arguments:
-*     None
+*     uint8_t *record: Buffer for the record (WORD_GUESS_CHECKPOINT_MAX_SIZE bytes)
+*     size_t *size: Size of the buffer, set to the size of the record
 * 
 * Returns:
-*      True if the guess is correct
-*      False if the guess is incorrect
+*      True if there is a game to resume
+*      False otherwise
 */
-bool validateGuess(void);
+bool loadCheckpoint(uint8_t *record, size_t *size);
+
+/*-----------------------------------------------------------
+Memory Constants
+------------------------------------------------------------*/
+
+const wordGuessBackend_t deviceBackend = {
+    .setButtonLeds = setButtonLeds,
+    .getWordToGuess = getWordToGuess,
+    .checkGuess = checkGuess,
+    .showHint = showHint,
+    .delayMs = delayMs,
+    .getDate = dailyWordToday,
+    .saveGame = gameCheckpointSave
+};
+
+/*-----------------------------------------------------------
+Statics
+------------------------------------------------------------*/
+
+static api_request_handle_t wordPrefetch = NULL;   // Word requested at boot, consumed by getWordToGuess
 
 /*-----------------------------------------------------------
 Functions
 ------------------------------------------------------------*/
 
-esp_err_t cycleCarousal(direction_t direcion)
+bool waitForApiRequest(api_request_handle_t request, char *result, int resultSize)
+{
+    uint64_t savedState[CASCADE_SIZE];
+    bool cursorEnabled = isCursorEnabled();
+    bool isCancelled = false;
+    bool isFinished = false;
+    uint8_t busyFrame = 0;
+    uint32_t ioNum;
+    uint32_t heldBack[GPIO_EVENT_QUEUE_LENGTH];
+    uint8_t heldBackCount = 0;
+    TickType_t startTicks = xTaskGetTickCount();
+
+    if(request == NULL)
+    {
+        return false;
+    }
+
+    // Already finished (e.g. prefetched), no need to touch the display
+    if(api_request_poll(request) == API_REQUEST_DONE)
+    {
+        return (api_request_take(request, result, resultSize) == ESP_OK);
+    }
+
+    // The busy indicator draws over the lower display, so save it first
+    getDisplayState(LOWER_DISPLAY, savedState);
+
+    if(cursorEnabled)
+    {
+        disableCursor();
+    }
+
+    while(!isCancelled)
+    {
+        if(api_request_wait(request, BUSY_FRAME_MS) == ESP_OK)
+        {
+            isFinished = true;
+            break;
+        }
+
+        if(xTaskGetTickCount() - startTicks >= pdMS_TO_TICKS(API_DEADLINE_MS))
+        {
+            ESP_LOGW(LOG_TAG, "Api request timed out");
+            break;
+        }
+
+        // Busy indicator, a '?' running along the lower display
+        for(uint8_t segment = 0; segment < CASCADE_SIZE; segment++)
+        {
+            setSymbol(segment == busyFrame ? UNKNOWN : NO_SELECTION, LOWER_DISPLAY, segment);
+        }
+        busyFrame = (busyFrame + 1) % CASCADE_SIZE;
+
+        // Handle the buttons that still make sense while waiting, keep the rest for later
+        // Once heldBack is full the rest stay in the queue (EXIT behind them waits too)
+        while(heldBackCount < GPIO_EVENT_QUEUE_LENGTH && xQueueReceive(gpioEventQueue, &ioNum, 0))
+        {
+            if(ioNum == EXIT_BTN)
+            {
+                ESP_LOGI(LOG_TAG, "Api request cancelled");
+                isCancelled = true;
+                break;
+            }
+            else if(ioNum == GPIO_JOY_UP)
+            {
+                wordGuessCoreChangeBrightness(UP);
+            }
+            else if(ioNum == GPIO_JOY_DOWN)
+            {
+                wordGuessCoreChangeBrightness(DOWN);
+            }
+            else
+            {
+                heldBack[heldBackCount++] = ioNum;
+            }
+        }
+    }
+
+    // Back in front of anything pressed since, last first so they come out in order
+    while(heldBackCount > 0)
+    {
+        heldBackCount--;
+        if(xQueueSendToFront(gpioEventQueue, &heldBack[heldBackCount], 0) != pdPASS)
+        {
+            ESP_LOGW(LOG_TAG, "Queue full, press dropped");
+        }
+    }
+
+    if(isFinished)
+    {
+        isFinished = (api_request_take(request, result, resultSize) == ESP_OK);
+    }
+    else
+    {
+        api_request_cancel(request);
+    }
+
+    setDisplayState(LOWER_DISPLAY, savedState);
+
+    if(cursorEnabled)
+    {
+        enableCursor();
+    }
+
+    return isFinished;
+}
+
+void toLowercase(char *str) 
 {
-    esp_err_t ret = ESP_OK;
+    for (int i = 0; str[i] != '\0'; i++) {
+        str[i] = tolower((unsigned char)str[i]); // Use tolower for each character
+    }
+}
 
-    switch(direcion)
+bool buttonToEvent(uint32_t ioNum, wordGuessEvent_t *event)
+{
+    switch(ioNum)
     {
-    case LEFT:
-        // Move the carousal to the left
-        carousalSlider.start = (carousalSlider.start - 1 + ALPHABET_COUNT) % ALPHABET_COUNT;
-        carousalSlider.mid = (carousalSlider.mid - 1 + ALPHABET_COUNT) % ALPHABET_COUNT;
-        carousalSlider.end = (carousalSlider.end - 1 + ALPHABET_COUNT) % ALPHABET_COUNT;
+    case SELECT_BTN:
+        *event = WORD_GUESS_EVENT_SELECT;
         break;
-    case RIGHT:
-        // Move the carousal to the right
-        carousalSlider.start = (carousalSlider.start + 1) % ALPHABET_COUNT;
-        carousalSlider.mid = (carousalSlider.mid + 1) % ALPHABET_COUNT;
-        carousalSlider.end = (carousalSlider.end + 1) % ALPHABET_COUNT;
+    case GUESS_BTN:
+        *event = WORD_GUESS_EVENT_GUESS;
         break;
-    default:
-        ESP_LOGE(LOG_TAG, "Invalid direction given");
+    case DELETE_BTN:
+        *event = WORD_GUESS_EVENT_DELETE;
+        break;
+    case EXIT_BTN:
+        *event = WORD_GUESS_EVENT_EXIT;
         break;
+    case GPIO_JOY_LEFT:
+        *event = WORD_GUESS_EVENT_LEFT;
+        break;
+    case GPIO_JOY_RIGHT:
+        *event = WORD_GUESS_EVENT_RIGHT;
+        break;
+    case GPIO_JOY_UP:
+        *event = WORD_GUESS_EVENT_UP;
+        break;
+    case GPIO_JOY_DOWN:
+        *event = WORD_GUESS_EVENT_DOWN;
+        break;
+    default:
+        return false;
     }
 
-    // Display the carousal
-    ret |= setSymbol(charToSymbol(carousalCharacters[carousalSlider.start]), LOWER_DISPLAY, CAROUSEL_START_SEGMENT);
-    ret |= setSymbol(charToSymbol(carousalCharacters[carousalSlider.mid]), LOWER_DISPLAY, CAROUSEL_MID_SEGMENT);
-    ret |= setSymbol(charToSymbol(carousalCharacters[carousalSlider.end]), LOWER_DISPLAY, CAROUSEL_END_SEGMENT);
+    return true;
+}
 
-    return ret;
+void setButtonLeds(uint8_t leds)
+{
+    gpio_set_level(SELECT_BTN_LED, (leds & WORD_GUESS_LED_SELECT) != 0);
+    gpio_set_level(GUESS_BTN_LED, (leds & WORD_GUESS_LED_GUESS) != 0);
+    gpio_set_level(DELETE_BTN_LED, (leds & WORD_GUESS_LED_DELETE) != 0);
+    gpio_set_level(EXIT_BTN_LED, (leds & WORD_GUESS_LED_EXIT) != 0);
 }
 
-esp_err_t displayCarousal(void)
+bool getWordToGuess(char *word, int wordSize)
 {
-    esp_err_t ret = ESP_OK;
+    char fetchedWord[WORD_SIZE] = {0};
+    bool isFetched = false;
 
-    disableCursor();
+    if(wordSize < WORD_SIZE)
+    {
+        return false;
+    }
 
-    // Display the carousal
-    for(uint8_t segment = 0; segment < CASCADE_SIZE; segment++)
+    // Cached in NVS after the first fetch of the day
+    if(dailyWordFromCache(word, wordSize))
     {
-        ret |= setSymbol(carousalScreenState[segment], LOWER_DISPLAY, segment);
+        // The prefetch is not needed anymore
+        if(wordPrefetch != NULL)
+        {
+            api_request_cancel(wordPrefetch);
+            wordPrefetch = NULL;
+        }
+
+        return true;
     }
 
-    enableCursor();
+    // Use the word prefetched at boot, it has usually arrived by now
+    if(wordPrefetch != NULL)
+    {
+        isFetched = waitForApiRequest(wordPrefetch, fetchedWord, WORD_SIZE) && isWordComplete(fetchedWord);
+        wordPrefetch = NULL;
+    }
 
-    return ret;
-}
+    // No prefetch, or it failed (e.g. the network was not ready yet)
+    // Don't wait out the request timeout when there is no network at all
+    if(!isFetched && wifi_is_connected())
+    {
+        isFetched = waitForApiRequest(api_request_get_word(), fetchedWord, WORD_SIZE) && isWordComplete(fetchedWord);
+    }
 
-esp_err_t displayResults(void)
-{
-    esp_err_t ret = ESP_OK;
+    if(isFetched)
+    {
+        memcpy(word, fetchedWord, WORD_SIZE);
+        dailyWordSave(word);
+        return true;
+    }
 
-    // Display the results
-    for(uint8_t segment = 0; segment < CASCADE_SIZE; segment++)
+    if(dailyWordOffline(word, wordSize))
     {
-        ret |= setSymbol(resultScreenState[segment], LOWER_DISPLAY, segment);
+        ESP_LOGW(LOG_TAG, "Api unreachable, playing the offline word");
+        return true;
     }
 
-    return ret;
+    return false;
 }
 
-void saveCarousalState(void)
+bool checkGuess(const char *guess, char *result, int resultSize)
 {
-    carousalScreenState[1] = charToSymbol(carousalCharacters[carousalSlider.start]);
-    carousalScreenState[2] = charToSymbol(carousalCharacters[carousalSlider.mid]);
-    carousalScreenState[3] = charToSymbol(carousalCharacters[carousalSlider.end]);
+    char word[WORD_SIZE];
+
+    memcpy(word, guess, WORD_SIZE);
+    word[WORD_SIZE - 1] = '\0';
+
+    toLowercase(word);
+
+    return waitForApiRequest(api_request_check_word(word), result, resultSize);
 }
 
-void toLowercase(char *str) 
+void delayMs(uint32_t ms)
 {
-    for (int i = 0; str[i] != '\0'; i++) {
-        str[i] = tolower((unsigned char)str[i]); // Use tolower for each character
-    }
+    vTaskDelay(pdMS_TO_TICKS(ms));
 }
 
 esp_err_t wordGuessGameReset(void)
 {
-    esp_err_t ret = ESP_OK;
+    esp_err_t ret = wordGuessCoreInit(&deviceBackend);
 
-    ESP_LOGI(LOG_TAG, "Reseting word guess game");
+    if(ret != ESP_OK)
+    {
+        return ret;
+    }
 
-    // Reset the carousal
-    memcpy(carousalScreenState, carousalScreenStartState, sizeof(carousalScreenState));
+    return wordGuessCoreReset();
+}
 
-    // Reset the carousal slider
-    carousalSlider.start = CAROUSEL_SLIDER_INIT_STRT;
-    carousalSlider.mid = CAROUSEL_SLIDER_INIT_MID;
-    carousalSlider.end = CAROUSEL_SLIDER_INIT_END;
+bool loadCheckpoint(uint8_t *record, size_t *size)
+{
+    uint32_t savedDate;
+    uint32_t today;
 
-    // Reset the results
-    memcpy(resultScreenState, resultsScreenStartState, sizeof(resultScreenState));
+    if(!gameCheckpointLoad(record, size))
+    {
+        return false;
+    }
 
-    // Reset the board
-    disableCursor();
-    ret |= resetBoard();
-    enableCursor();
+    savedDate = wordGuessCoreCheckpointDate(record, *size);
 
-    // Reset brightness
-    screenBrightness = DEFAULT_BRIGHTNESS;
-    setBrightness(screenBrightness);
+    if(savedDate != 0 && dailyWordToday(&today) && savedDate != today)
+    {
+        ESP_LOGI(LOG_TAG, "Game from %lu dropped, it is %lu", (unsigned long)savedDate, (unsigned long)today);
+        gameCheckpointSave(NULL, 0);
+        return false;
+    }
 
-    // Reset the wordToGuess 
-    memset(wordToGuess, '-', sizeof(wordToGuess));
-    wordToGuess[WORD_SIZE - 1] = '\0';
+    return true;
+}
 
-    // Retreive the word to guess
-    api_get_word(wordToGuess, WORD_SIZE);
-    // memcpy(wordToGuess, "HELLO", WORD_SIZE);
-    ESP_LOGI(LOG_TAG, "Word to guess: %s", wordToGuess);
+void wordGuessGamePrefetch(void)
+{
+    char cachedWord[WORD_SIZE];
+    uint8_t record[WORD_GUESS_CHECKPOINT_MAX_SIZE];
+    size_t recordSize = sizeof(record);
 
-    // Reset the guessedWord
-    memset(guessedWord, '-', sizeof(guessedWord));
-    guessedWord[WORD_SIZE - 1] = '\0';
+    // Nothing to fetch if today's word is already cached, or with no network
+    if(wordPrefetch != NULL || dailyWordFromCache(cachedWord, WORD_SIZE) || !wifi_is_connected())
+    {
+        return;
+    }
 
-    // Reset the guess count
-    guessCount = 0;
+    // A game cut short by a reset today is picked back up with its own word
+    if(loadCheckpoint(record, &recordSize))
+    {
+        return;
+    }
 
-    // Reset the game state
-    gameState = INIT;
+    wordPrefetch = api_request_get_word();
 
-    return ESP_OK;
+    if(wordPrefetch == NULL)
+    {
+        ESP_LOGW(LOG_TAG, "Could not queue the word prefetch");
+    }
 }
 
 esp_err_t wordGuessGameStart(void)
 {   
     bool isRunning = true;
+    bool isHeld;
+    uint16_t repeats;
+    uint32_t holdDelayMs;
+    TickType_t stepTicks;
     uint32_t ioNum;
-    char seclectedChar;
-    uint8_t cursorPos = 2;
-    uint8_t cursorPos2 = 2; // TODO: Find a better name
-    symbols_t convertedChar;
+    wordGuessEvent_t event;
+    wordGuessGameStates_t state;
+    int64_t eventTime;
+    uint8_t record[WORD_GUESS_CHECKPOINT_MAX_SIZE];
+    size_t recordSize = sizeof(record);
 
     ESP_LOGI(LOG_TAG, "Starting word guess game");
 
-    while(isRunning)
+    // Needs the dictionary, loaded before the game starts
+    if(!wordSolverInit())
+    {
+        ESP_LOGW(LOG_TAG, "No answer list, candidates left not available");
+    }
+    else if(wordHintInit() != ESP_OK)
     {
+        ESP_LOGW(LOG_TAG, "Could not start the hint workers");
+    }
 
-        // Set option button LEDs based on game state
-        switch(gameState)
-        {
-        case INIT:
-            gpio_set_level(SELECT_BTN_LED, 1);
-            gpio_set_level(GUESS_BTN_LED, 0);
-            gpio_set_level(DELETE_BTN_LED, 0);
-            gpio_set_level(EXIT_BTN_LED, 1);
-            break;
-        case LETTER_SELECTION:
-            gpio_set_level(SELECT_BTN_LED, 1);
-            gpio_set_level(GUESS_BTN_LED, 0);
-            gpio_set_level(DELETE_BTN_LED, 0);
-            gpio_set_level(EXIT_BTN_LED, 1);
-            break;
-        case LETTER_EDIT:
-            gpio_set_level(SELECT_BTN_LED, 1);
-            gpio_set_level(GUESS_BTN_LED, 1);
-            gpio_set_level(DELETE_BTN_LED, 1);
-            gpio_set_level(EXIT_BTN_LED, 1);
-            break;
-        case RESULTS:
-            gpio_set_level(SELECT_BTN_LED, 0);
-            gpio_set_level(GUESS_BTN_LED, 0);
-            gpio_set_level(DELETE_BTN_LED, 0);
-            gpio_set_level(EXIT_BTN_LED, 1);
-            break;
-        default:
-            ESP_LOGE(LOG_TAG, "Given invalid game state");
-            break;
-        }
+    if(wordGuessCoreInit(&deviceBackend) != ESP_OK)
+    {
+        return ESP_FAIL;
+    }
+
+    // Straight back into a game cut short by a reset, no word fetch and no start screen
+    if(loadCheckpoint(record, &recordSize) && wordGuessCoreResume(record, recordSize) != ESP_OK)
+    {
+        // Can't be played, don't try it again next boot
+        gameCheckpointSave(NULL, 0);
+    }
 
+    while(isRunning)
+    {
         if(xQueueReceive(gpioEventQueue, &ioNum, portMAX_DELAY)) 
         {
             // printf("GPIO[%"PRIu32"] intr\n", ioNum);
 
-            if(ioNum == SELECT_BTN || ioNum == GUESS_BTN || ioNum == DELETE_BTN || ioNum == EXIT_BTN) 
+            if(!buttonToEvent(ioNum, &event))
             {
-                switch (ioNum)
-                {
-                /*-------------------------------------------------------
-                * ---------- SELECT_BTN
-                *-------------------------------------------------------*/
-                case SELECT_BTN:
-                    switch(gameState)
-                    {
-                    case INIT:
-                        wordGuessGameReset();
-                        gameState = LETTER_EDIT;
-                        break;
-                    case LETTER_SELECTION:
-                        // Get the selected character
-                        seclectedChar = getCharAtCursor();
-                        
-                        // Convert the character to a symbol
-                        convertedChar = charToSymbol(seclectedChar);
-
-                        // Make sure the character is valid
-                        if(convertedChar != INVALID_SYMBOL)
-                        {   
-                            // Disable the cursor 
-                            // This is as a fix for a bug that I dont have time to fix
-                            disableCursor();
-
-                            // Set the character on the display
-                            setSymbol(convertedChar, UPPER_DISPLAY, cursorPos);
-                            
-                            // Re-enable the cursor
-                            enableCursor();
-
-                            // Save the carousal state
-                            saveCarousalState();
-
-                            // Display the result screen
-                            displayResults();
-
-                            // Reset the cursor
-                            resetCursor();
-
-                            // Set the next game state 
-                            gameState = LETTER_EDIT;
-                        }
-                        else
-                        {
-                            ESP_LOGE(LOG_TAG, "Invalid character selected");
-                        }
-
-                        break;
-                    case LETTER_EDIT:
-                        // Set the next game state
-                        gameState = LETTER_SELECTION;
-
-                        // Get cursor position
-                        cursorPos = getCursorPos();
-
-                        // Get the cursor to the center
-                        moveCursorMultiple(RIGHT, (2 - cursorPos + CASCADE_SIZE) % CASCADE_SIZE);
-
-                        displayCarousal();
-
-                        moveCursor(DOWN);
-                        break;
-                    case RESULTS:
-                        // Do nothing, no functionality for this button in this state
-                        break;
-                    default:
-                        ESP_LOGE(LOG_TAG, "Given invalid game state");
-                        break;
-                    }
-                    break;
-
-                /*-------------------------------------------------------
-                * ---------- GUESS_BTN
-                *-------------------------------------------------------*/
-                case GUESS_BTN:
-                    switch(gameState)
-                    {
-                    case INIT:
-                        // Do nothing, no functionality for this button in this state
-                        break;
-                    case LETTER_SELECTION:
-                        // Do nothing, no functionality for this button in this state
-                        break;
-                    case LETTER_EDIT:
-                        getWord(guessedWord, sizeof(guessedWord));
-
-                        ESP_LOGI(LOG_TAG, "Word guessed is: %s", guessedWord);
-
-                        if(validateGuess())
-                        {
-                            ESP_LOGI(LOG_TAG, "Word guessed is correct");
-
-                            gameState = RESULTS;
-                        }
-                        else
-                        {
-                            ESP_LOGI(LOG_TAG, "Word guessed is incorrect");
-
-                            ++guessCount;
-
-                            if(guessCount >= MAX_GUESSES)
-                            {
-                                // Set the results screen to the word to guess
-                                for(uint8_t segment = 0; segment < CASCADE_SIZE; segment++)
-                                {
-                                    resultScreenState[segment] = charToSymbol(wordToGuess[segment]);
-                                }
-
-                                ESP_LOG_BUFFER_HEXDUMP(LOG_TAG, wordToGuess, WORD_SIZE, ESP_LOG_DEBUG);
-                                ESP_LOGI(LOG_TAG, "------");
-                                ESP_LOG_BUFFER_HEXDUMP(LOG_TAG, resultScreenState, CASCADE_SIZE, ESP_LOG_DEBUG);
-
-                                // Update the results screen
-                                displayResults();
-
-                                gameState = RESULTS;
-                            }
-                            else
-                            {
-                                ESP_LOGI(LOG_TAG, "Guesses left: %d", MAX_GUESSES - guessCount);
-
-                                gameState = LETTER_EDIT;
-                            }
-                        }
-
-                        disableCursor();
-
-                        displayResults();
-
-                        enableCursor();
-
-                        resetCursor();
-
-                        break;
-                    case RESULTS:
-                        // Do nothing, no functionality for this button in this state
-                        break;
-                    default:
-                        ESP_LOGE(LOG_TAG, "Given invalid game state");
-                        break;
-                    }
-                    break;
-                
-                /*-------------------------------------------------------
-                * ---------- DELETE_BTN
-                *-------------------------------------------------------*/
-                case DELETE_BTN:
-                    switch(gameState)
-                    {
-                    case INIT:
-                        // Do nothing, no functionality for this button in this state
-                        break;
-                    case LETTER_SELECTION:
-                        // Do nothing, no functionality for this button in this state
-                        //TODO: maybe delete all characters in the word of the selected character
-                        break;
-                    case LETTER_EDIT:
-                        // Get cursor position
-                        cursorPos = getCursorPos();
-
-                        // Convert the character to a symbol
-                        convertedChar = charToSymbol('-');
-
-                        // Set the character on the display only if the symbol is valid
-                        if(convertedChar != INVALID_SYMBOL)
-                        {
-                            setSymbol(convertedChar, UPPER_DISPLAY, cursorPos);
-                        }
-                        else
-                        {
-                            ESP_LOGE(LOG_TAG, "Invalid character selected");
-                        }
-
-                        break;
-                    case RESULTS:
-                        // Do nothing, no functionality for this button in this state
-                        break;
-                    default:
-                        ESP_LOGE(LOG_TAG, "Given invalid game state");
-                        break;
-                    }
-                    break;
-
-                /*-------------------------------------------------------
-                * ---------- EXIT_BTN
-                *-------------------------------------------------------*/
-                case EXIT_BTN:
-                    switch(gameState)
-                    {
-                    case LETTER_SELECTION:
-                        // Save the carousal state
-                        saveCarousalState();
-
-                        // Display the result screen
-                        displayResults();
-
-                        // Reset the cursor
-                        resetCursor();
-
-                        gameState = LETTER_EDIT;
-                        break;
-                    case INIT:
-                    case LETTER_EDIT:
-                    case RESULTS:
-                        displayFullGraphic(exitScreen, sizeof(exitScreen));
-
-                        gpio_set_level(SELECT_BTN_LED, 0);
-                        gpio_set_level(GUESS_BTN_LED, 0);
-                        gpio_set_level(DELETE_BTN_LED, 0);
-                        gpio_set_level(EXIT_BTN_LED, 0);
-
-                        isRunning = false;
-                        break;
-                    default:
-                        ESP_LOGE(LOG_TAG, "Given invalid game state");
-                        break;
-                    }
-                    break;
-                    ESP_LOGI(LOG_TAG, "Exiting word guess game");
-                
-                default:
-                    break;
-                }
+                continue;
             }
-            else if(ioNum == GPIO_JOY_LEFT || ioNum == GPIO_JOY_RIGHT || ioNum == GPIO_JOY_UP || ioNum == GPIO_JOY_DOWN) 
+
+            state = wordGuessCoreGetState();
+            eventTime = esp_timer_get_time();
+
+            // Accommodate long press, LEFT and RIGHT keep stepping while held when editing
+            isHeld = (event == WORD_GUESS_EVENT_LEFT || event == WORD_GUESS_EVENT_RIGHT) &&
+                     (state == LETTER_SELECTION || state == LETTER_EDIT) && gpio_get_level(ioNum) == 0;
+
+            if(isHeld)
             {
-                switch (ioNum)
+                repeats = 0;
+
+                while(isRunning && gpio_get_level(ioNum) == 0)
                 {
-                /*-------------------------------------------------------
-                * ---------- LEFT
-                *-------------------------------------------------------*/
-                case GPIO_JOY_LEFT:
-                    switch(gameState)
-                    {
-                    case INIT:
-                        // Do nothing, no functionality for this button in this state
-                        break;
-                    case LETTER_SELECTION:
-                        // Accommodate long press
-                        if(gpio_get_level(GPIO_JOY_LEFT) == 0)
-                        {
-                            while(gpio_get_level(GPIO_JOY_LEFT) == 0)
-                            {
-                                cursorPos2 = getCursorPos();
-
-                                if(cursorPos2 == CAROUSEL_START_SEGMENT)
-                                {
-                                    // Move the carousal to the left
-                                    cycleCarousal(LEFT);
-                                }
-                                else
-                                {
-                                    // Move the cursor to the left
-                                    moveCursor(LEFT);
-                                }
-                                vTaskDelay(pdMS_TO_TICKS(BTN_HOLD_DELAY_MS));
-                            }
-                        }
-                        // Accommodate single press
-                        else
-                        {
-                            // Get the cursor position
-                            cursorPos2 = getCursorPos();
-
-                            if(cursorPos2 == CAROUSEL_START_SEGMENT)
-                            {
-                                // Move the carousal to the left
-                                cycleCarousal(LEFT);
-                            }
-                            else
-                            {
-                                // Move the cursor to the left
-                                moveCursor(LEFT);
-                            }
-                        }
-                        break;
-                    case LETTER_EDIT:
-                        // Accommodate long press
-                        if(gpio_get_level(GPIO_JOY_LEFT) == 0)
-                        {
-                            while(gpio_get_level(GPIO_JOY_LEFT) == 0)
-                            {
-                                moveCursor(LEFT);
-                                vTaskDelay(pdMS_TO_TICKS(BTN_HOLD_DELAY_MS));
-                            }
-                        }
-                        // Accommodate single press
-                        else
-                        {
-                            moveCursor(LEFT);
-                        }
-                        break;
-                    case RESULTS:
-                        // Do nothing, no functionality for this button in this state
-                        break;
-                    default:
-                        ESP_LOGE(LOG_TAG, "Given invalid game state");
-                        break;
-                    }
-                    break;
-
-                /*-------------------------------------------------------
-                * ---------- RIGHT
-                *-------------------------------------------------------*/
-                case GPIO_JOY_RIGHT:
-                    switch(gameState)
-                    {
-                    case INIT:
-                        // Do nothing, no functionality for this button in this state
-                        break;
-                    case LETTER_SELECTION:
-                        // Accommodate long press
-                        if(gpio_get_level(GPIO_JOY_RIGHT) == 0)
-                        {
-                            while(gpio_get_level(GPIO_JOY_RIGHT) == 0)
-                            {
-                                cursorPos2 = getCursorPos();
-
-                                if(cursorPos2 == CAROUSEL_END_SEGMENT)
-                                {
-                                    // Move the carousal to the right
-                                    cycleCarousal(RIGHT);
-                                }
-                                else
-                                {
-                                    // Move the cursor to the right
-                                    moveCursor(RIGHT);
-                                }
-                                vTaskDelay(pdMS_TO_TICKS(BTN_HOLD_DELAY_MS));
-                            }
-                        }
-                        // Accommodate single press
-                        else
-                        {
-                            // Get the cursor position
-                            cursorPos2 = getCursorPos();
-
-                            if(cursorPos2 == CAROUSEL_END_SEGMENT)
-                            {
-                                // Move the carousal to the right
-                                cycleCarousal(RIGHT);
-                            }
-                            else
-                            {
-                                // Move the cursor to the right
-                                moveCursor(RIGHT);
-                            }
-                        }
-                        break;
-                    case LETTER_EDIT:
-                        // Accommodate long press
-                        if(gpio_get_level(GPIO_JOY_RIGHT) == 0)
-                        {
-                            while(gpio_get_level(GPIO_JOY_RIGHT) == 0)
-                            {
-                                moveCursor(RIGHT);
-                                vTaskDelay(pdMS_TO_TICKS(BTN_HOLD_DELAY_MS));
-                            }
-                        }
-                        // Accommodate single press
-                        else
-                        {
-                            moveCursor(RIGHT);
-                        }
-                        break;
-                    case RESULTS:
-                        // Do nothing, no functionality for this button in this state
-                        break;
-                    default:
-                        ESP_LOGE(LOG_TAG, "Given invalid game state");
-                        break;
-                    }
-                    break;
-
-                /*-------------------------------------------------------
-                * ---------- UP
-                *-------------------------------------------------------*/
-                case GPIO_JOY_UP:
-                    switch(gameState)
-                    {
-                    case INIT:
-                    case LETTER_SELECTION:
-                    case LETTER_EDIT:
-                    case RESULTS:
-                        if(++screenBrightness > MAX_BRIGHTNESS)
-                        {
-                            screenBrightness = MAX_BRIGHTNESS;
-                        }
-
-                        setBrightness(screenBrightness);
-                        ESP_LOGI(LOG_TAG, "Brightness: %d", screenBrightness);
-                        break;
-                    default:
-                        ESP_LOGE(LOG_TAG, "Given invalid game state");
-                        break;
-                    }
-                    break;
-
-                /*-------------------------------------------------------
-                * ---------- DOWN
-                *-------------------------------------------------------*/
-                case GPIO_JOY_DOWN:
-                    switch(gameState)
-                    {
-                    case INIT:
-                    case LETTER_SELECTION:
-                    case LETTER_EDIT:
-                    case RESULTS:
-                        if(--screenBrightness > MAX_BRIGHTNESS)
-                        {
-                            screenBrightness = 0;
-                        }
-
-                        setBrightness(screenBrightness);
-                        ESP_LOGI(LOG_TAG, "Brightness: %d", screenBrightness);
-                        break;
-                    default:
-                        ESP_LOGE(LOG_TAG, "Given invalid game state");
-                        break;
-                    }
-                    // moveCursor(DOWN);
-                    break;
-                
-                default:
-                    break;
+                    // Steps speed up the longer it is held, the carousal slides for half
+                    // of each step and the letter rests in place for the other half
+                    holdDelayMs = wordGuessCoreHoldDelay(repeats++);
+                    wordGuessCoreSetSlideTime(holdDelayMs / 2);
+
+                    stepTicks = xTaskGetTickCount();
+                    isRunning = wordGuessCoreHandleEvent(event);
+                    vTaskDelayUntil(&stepTicks, pdMS_TO_TICKS(holdDelayMs));
                 }
+
+                wordGuessCoreSetSlideTime(wordGuessCoreHoldDelay(0) / 2);
+            }
+            // Accommodate single press
+            else
+            {
+                isRunning = wordGuessCoreHandleEvent(event);
             }
-            // ESP_LOGD(LOG_TAG, "Character is: %c", getCharAtCursor());
-            // getWord(word, sizeof(word));
-            // ESP_LOGD(LOG_TAG, "Word is: %s", word);
 
+            if(state == INIT && event == WORD_GUESS_EVENT_SELECT)
+            {
+                ESP_LOGI(LOG_TAG, "Select to board: %lld ms", (esp_timer_get_time() - eventTime) / 1000);
+            }
         }
     }
 
     return ESP_OK;
 }
 
-bool validateGuess(void)
+void showHint(void)
 {
-    bool isCorrect = true;
-    char guessResults[WORD_SIZE];
+    uint64_t savedState[CASCADE_SIZE];
+    bool cursorEnabled = isCursorEnabled();
+    char suggestion[WORD_SIZE];
+    uint32_t ioNum;
 
-    memcpy(guessResults, guessedWord, WORD_SIZE);
+    getDisplayState(LOWER_DISPLAY, savedState);
 
-    toLowercase(guessResults);
-    
-    api_check_word(guessResults, WORD_SIZE);
-    // memcpy(guessResults, "++--x", WORD_SIZE);
-    // memcpy(guessResults, "+++++", WORD_SIZE);
+    if(cursorEnabled)
+    {
+        disableCursor();
+    }
 
-    // Set the results
-    for(uint8_t segment = 0; segment < CASCADE_SIZE; segment++)
-    {   
-        // Get the equivalent symbol for the character
-        for(uint8_t character = 0; character < WORD_SIZE; character++)
-        {
-            if(guessResults[segment] == apiCharMap[character].apiChar)
-            {
-                resultScreenState[segment] = apiCharMap[character].equivalentSymbol;
-                break;
-            }
-        }
+    displayNumber(LOWER_DISPLAY, wordSolverCandidateCount());
 
-        // Flip the is correct flag if at least one character is incorrect
-        if( isCorrect && resultScreenState[segment] != CORRECT)
+    // The button that clears it is used up, GUESS asks for a suggestion
+    if(xQueueReceive(gpioEventQueue, &ioNum, pdMS_TO_TICKS(CANDIDATES_SHOW_MS)) == pdTRUE && ioNum == GUESS_BTN &&
+       wordHintSuggest(suggestion, WORD_SIZE, hintProgress))
+    {
+        for(uint8_t segment = 0; segment < CASCADE_SIZE; segment++)
         {
-            isCorrect = false;
+            setSymbol(charToSymbol(suggestion[segment]), LOWER_DISPLAY, segment);
         }
+
+        xQueueReceive(gpioEventQueue, &ioNum, pdMS_TO_TICKS(HINT_SHOW_MS));
+    }
+
+    setDisplayState(LOWER_DISPLAY, savedState);
+
+    if(cursorEnabled)
+    {
+        enableCursor();
     }
+}
 
-    return isCorrect;
- }
+bool hintProgress(void)
+{
+    static uint8_t busyFrame = 0;
+    uint32_t ioNum;
+
+    // Same busy indicator as the api wait, a '?' running along the lower display
+    for(uint8_t segment = 0; segment < CASCADE_SIZE; segment++)
+    {
+        setSymbol(segment == busyFrame ? UNKNOWN : NO_SELECTION, LOWER_DISPLAY, segment);
+    }
+    busyFrame = (busyFrame + 1) % CASCADE_SIZE;
+
+    return xQueueReceive(gpioEventQueue, &ioNum, 0) == pdTRUE;
+}
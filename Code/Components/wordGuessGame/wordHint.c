@@ -0,0 +1,376 @@
+#include "esp_log.h"
+#include "esp_timer.h"
+#include <stdlib.h>
+#include <stdint.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "wordDictionary.h"
+#include "wordSolver.h"
+#include "wordHint.h"
+#include "openingBook.h"
+
+/*-----------------------------------------------------------
+Literal Constants
+------------------------------------------------------------*/
+
+#define LOG_TAG "WordHint"
+
+#define WORD_SIZE 6 // 5 characters + null terminator
+
+#define HINT_WORKER_COUNT       portNUM_PROCESSORS
+#define HINT_WORKER_STACK_SIZE  3072
+#define HINT_WORKER_PRIORITY    (tskIDLE_PRIORITY + 1)
+
+#define HINT_CHUNK_SIZE     32  // Guesses scored per chunk
+#define HINT_PROGRESS_MS    100 // How often the caller's progress callback runs
+#define HINT_YIELD_MS       100 // Workers let the idle task run this often (task watchdog)
+
+// With this few answers left, any of them is as good as a search
+#define HINT_DIRECT_PICK_MAX 2
+
+/*-----------------------------------------------------------
+Types
+------------------------------------------------------------*/
+
+typedef struct
+{
+    // Chunks still to do, taken from the front by the owner and stolen from the back
+    uint32_t nextChunk;
+    uint32_t endChunk;
+
+    // Best guess this worker scored
+    uint32_t bestGuess;
+    float bestScore;
+
+    uint32_t chunksScored;
+    uint32_t chunksStolen;
+} hintWorker_t;
+
+/*-----------------------------------------------------------
+Statics
+------------------------------------------------------------*/
+
+static hintWorker_t workers[HINT_WORKER_COUNT];
+static TaskHandle_t workerTasks[HINT_WORKER_COUNT];
+static SemaphoreHandle_t workersDone = NULL;
+static portMUX_TYPE scheduleLock = portMUX_INITIALIZER_UNLOCKED;
+static volatile bool isStopped = false;
+
+// Answers left for the current search, packed, shared read only by the workers
+static uint32_t *answers = NULL;
+static uint32_t answerCount = 0;
+
+/*-----------------------------------------------------------
+Local Function Prototypes
+------------------------------------------------------------*/
+
+/*
+* Description:
+*      Hands the worker its next chunk, from its own range or, once that is
+*      empty, by stealing the back half of another worker's range
+*
+* Arguments:
+*     uint8_t self: The worker asking
+*     uint32_t *chunk: Where to store the chunk
+*
+* Returns:
+*      True if a chunk was handed out
+*      False if every chunk is taken
+*/
+static bool takeChunk(uint8_t self, uint32_t *chunk);
+
+
+/*
+* Description:
+*      Worker task, scores chunks of guesses each time it is notified
+*
+* Arguments:
+*     void *arg: The worker number
+*
+* Returns:
+*      None
+*/
+static void hintWorkerTask(void *arg);
+
+
+/*
+* Description:
+*      Looks up the hint in the opening book, for the first guess and for
+*      the second when the first was the book's opener
+*
+* Arguments:
+*     uint32_t *guess: Where to store the packed suggestion
+*
+* Returns:
+*      True if the book has the hint
+*      False if a search is needed
+*/
+static bool bookSuggestion(uint32_t *guess);
+
+/*-----------------------------------------------------------
+Functions
+------------------------------------------------------------*/
+
+static bool takeChunk(uint8_t self, uint32_t *chunk)
+{
+    bool isTaken = false;
+    uint32_t remaining;
+    uint32_t stolen;
+
+    taskENTER_CRITICAL(&scheduleLock);
+
+    if(workers[self].nextChunk < workers[self].endChunk)
+    {
+        *chunk = workers[self].nextChunk++;
+        isTaken = true;
+    }
+    else
+    {
+        for(uint8_t other = 0; other < HINT_WORKER_COUNT && !isTaken; other++)
+        {
+            if(other == self || workers[other].nextChunk >= workers[other].endChunk)
+            {
+                continue;
+            }
+
+            // The victim keeps the front half it is working towards
+            remaining = workers[other].endChunk - workers[other].nextChunk;
+            stolen = (remaining + 1) / 2;
+            workers[other].endChunk -= stolen;
+            workers[self].nextChunk = workers[other].endChunk;
+            workers[self].endChunk = workers[self].nextChunk + stolen;
+            workers[self].chunksStolen += stolen;
+
+            *chunk = workers[self].nextChunk++;
+            isTaken = true;
+        }
+    }
+
+    taskEXIT_CRITICAL(&scheduleLock);
+
+    return isTaken;
+}
+
+static void hintWorkerTask(void *arg)
+{
+    uint8_t self = (uint8_t)(uintptr_t)arg;
+    hintWorker_t *worker = &workers[self];
+    uint32_t guessCount;
+    uint32_t chunk;
+    uint32_t guess;
+    uint32_t lastGuess;
+    float score;
+    TickType_t lastYield;
+
+    for(;;)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        guessCount = wordDictionarySize();
+        lastYield = xTaskGetTickCount();
+
+        while(!isStopped && takeChunk(self, &chunk))
+        {
+            lastGuess = (chunk + 1) * HINT_CHUNK_SIZE;
+            lastGuess = lastGuess < guessCount ? lastGuess : guessCount;
+
+            for(guess = chunk * HINT_CHUNK_SIZE; guess < lastGuess; guess++)
+            {
+                score = wordSolverScoreGuess(wordDictionaryGet(guess), answers, answerCount);
+
+                // Ties go to the first word, so the hint does not depend on the split
+                if(score > worker->bestScore || (score == worker->bestScore && guess < worker->bestGuess))
+                {
+                    worker->bestScore = score;
+                    worker->bestGuess = guess;
+                }
+            }
+
+            worker->chunksScored++;
+
+            if(xTaskGetTickCount() - lastYield >= pdMS_TO_TICKS(HINT_YIELD_MS))
+            {
+                vTaskDelay(1);
+                lastYield = xTaskGetTickCount();
+            }
+        }
+
+        xSemaphoreGive(workersDone);
+    }
+}
+
+static bool bookSuggestion(uint32_t *guess)
+{
+    uint32_t firstGuess;
+    uint8_t firstPattern;
+
+    // Made for another word list
+    if(openingBook.wordCount != wordDictionarySize() || openingBook.answerCount != wordDictionaryAnswerCount())
+    {
+        return false;
+    }
+
+    if(wordSolverAppliedCount() == 0)
+    {
+        *guess = openingBook.opener;
+    }
+    else if(wordSolverAppliedCount() == 1 && wordSolverFirstResult(&firstGuess, &firstPattern) &&
+            firstGuess == openingBook.opener)
+    {
+        *guess = openingBook.replies[firstPattern];
+    }
+    else
+    {
+        return false;
+    }
+
+    return *guess != DICTIONARY_INVALID_WORD;
+}
+
+esp_err_t wordHintInit(void)
+{
+    if(workersDone != NULL)
+    {
+        return ESP_OK;
+    }
+
+    workersDone = xSemaphoreCreateCounting(HINT_WORKER_COUNT, 0);
+
+    if(workersDone == NULL)
+    {
+        return ESP_ERR_NO_MEM;
+    }
+
+    for(uint8_t worker = 0; worker < HINT_WORKER_COUNT; worker++)
+    {
+        if(xTaskCreatePinnedToCore(hintWorkerTask, "hint_worker", HINT_WORKER_STACK_SIZE, (void *)(uintptr_t)worker,
+                                   HINT_WORKER_PRIORITY, &workerTasks[worker], worker) != pdPASS)
+        {
+            ESP_LOGE(LOG_TAG, "Failed to create hint worker %d", worker);
+
+            // Leave nothing half set up, wordHintSuggest only runs with every worker there
+            while(worker > 0)
+            {
+                worker--;
+                vTaskDelete(workerTasks[worker]);
+                workerTasks[worker] = NULL;
+            }
+            vSemaphoreDelete(workersDone);
+            workersDone = NULL;
+
+            return ESP_ERR_NO_MEM;
+        }
+    }
+
+    return ESP_OK;
+}
+
+bool wordHintSuggest(char *word, int wordSize, wordHintProgress_t progress)
+{
+    uint32_t chunkCount = (wordDictionarySize() + HINT_CHUNK_SIZE - 1) / HINT_CHUNK_SIZE;
+    int64_t startTime = esp_timer_get_time();
+    uint8_t finishedWorkers = 0;
+    hintWorker_t *best = NULL;
+    uint32_t bookGuess;
+
+    if(word == NULL || wordSize < WORD_SIZE || workersDone == NULL)
+    {
+        return false;
+    }
+
+    if(bookSuggestion(&bookGuess))
+    {
+        wordDictionaryUnpack(bookGuess, word);
+        ESP_LOGI(LOG_TAG, "Hint %s from the opening book", word);
+        return true;
+    }
+
+    answerCount = wordSolverCandidateCount();
+
+    if(answerCount == 0)
+    {
+        return false;
+    }
+
+    answers = malloc(answerCount * sizeof(uint32_t));
+
+    if(answers == NULL)
+    {
+        return false;
+    }
+
+    answerCount = wordSolverListCandidates(answers, answerCount);
+
+    for(uint32_t answer = 0; answer < answerCount; answer++)
+    {
+        answers[answer] = wordDictionaryGetAnswer(answers[answer]);
+    }
+
+    if(answerCount <= HINT_DIRECT_PICK_MAX)
+    {
+        wordDictionaryUnpack(answers[0], word);
+        free(answers);
+        answers = NULL;
+        return true;
+    }
+
+    // Even split to start with, stealing evens out the rest
+    isStopped = false;
+
+    for(uint8_t worker = 0; worker < HINT_WORKER_COUNT; worker++)
+    {
+        workers[worker].nextChunk = chunkCount * worker / HINT_WORKER_COUNT;
+        workers[worker].endChunk = chunkCount * (worker + 1) / HINT_WORKER_COUNT;
+        workers[worker].bestGuess = UINT32_MAX;
+        workers[worker].bestScore = -1;
+        workers[worker].chunksScored = 0;
+        workers[worker].chunksStolen = 0;
+    }
+
+    for(uint8_t worker = 0; worker < HINT_WORKER_COUNT; worker++)
+    {
+        xTaskNotifyGive(workerTasks[worker]);
+    }
+
+    // The workers always finish their chunk, so wait for all of them even when stopped
+    while(finishedWorkers < HINT_WORKER_COUNT)
+    {
+        if(xSemaphoreTake(workersDone, pdMS_TO_TICKS(HINT_PROGRESS_MS)) == pdTRUE)
+        {
+            finishedWorkers++;
+        }
+        else if(!isStopped && progress != NULL && progress())
+        {
+            isStopped = true;
+        }
+    }
+
+    for(uint8_t worker = 0; worker < HINT_WORKER_COUNT; worker++)
+    {
+        ESP_LOGD(LOG_TAG, "Core %d: %lu chunks, %lu stolen", worker,
+                 (unsigned long)workers[worker].chunksScored, (unsigned long)workers[worker].chunksStolen);
+
+        if(best == NULL || workers[worker].bestScore > best->bestScore ||
+           (workers[worker].bestScore == best->bestScore && workers[worker].bestGuess < best->bestGuess))
+        {
+            best = &workers[worker];
+        }
+    }
+
+    free(answers);
+    answers = NULL;
+
+    if(isStopped || best->bestGuess == UINT32_MAX)
+    {
+        ESP_LOGI(LOG_TAG, "Hint stopped after %lld ms", (esp_timer_get_time() - startTime) / 1000);
+        return false;
+    }
+
+    wordDictionaryUnpack(wordDictionaryGet(best->bestGuess), word);
+
+    ESP_LOGI(LOG_TAG, "Hint %s (%.2f bits) for %lu answers in %lld ms", word, best->bestScore,
+             (unsigned long)answerCount, (esp_timer_get_time() - startTime) / 1000);
+
+    return true;
+}
@@ -0,0 +1,396 @@
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "wordDictionary.h"
+#include "guessEvaluator.h"
+#include "wordSolver.h"
+
+/*-----------------------------------------------------------
+Literal Constants
+------------------------------------------------------------*/
+
+#define LETTER_COUNT 26
+
+// Most times a letter shows up in one answer ("eerie", "mamma")
+#define MAX_LETTER_REPEAT 3
+
+// Results as base 3 numbers, one digit per letter ('-' = 0, 'x' = 1, '+' = 2)
+#define PATTERN_ALL_CORRECT (WORD_SOLVER_PATTERN_COUNT - 1)
+
+/*-----------------------------------------------------------
+Macros
+------------------------------------------------------------*/
+
+// Maps 'a'-'z' and 'A'-'Z' to 0 - 25, anything else to >= LETTER_COUNT
+#define LETTER_INDEX(c) ((uint8_t)(((c) | 0x20) - 'a'))
+
+// Letter at a position of a packed word, first letter in the highest bits
+#define PACKED_LETTER(packed, pos) (((packed) >> (DICTIONARY_BITS_PER_LETTER * (GUESS_LETTER_COUNT - 1 - (pos)))) & 0x1F)
+
+// Answers with the letter at the position
+#define POSITION_MASK(pos, letter) (&positionMasks[((pos) * LETTER_COUNT + (letter)) * bitsetWords])
+
+// Answers with at least count of the letter (count 1 to MAX_LETTER_REPEAT)
+#define COUNT_MASK(count, letter) (&countMasks[(((count) - 1) * LETTER_COUNT + (letter)) * bitsetWords])
+
+/*-----------------------------------------------------------
+Statics
+------------------------------------------------------------*/
+
+static uint32_t answerCount = 0;
+static uint32_t bitsetWords = 0;       // uint32_t words per bitset
+static uint32_t *candidates = NULL;
+static uint32_t *positionMasks = NULL; // GUESS_LETTER_COUNT x LETTER_COUNT bitsets
+static uint32_t *countMasks = NULL;    // MAX_LETTER_REPEAT x LETTER_COUNT bitsets
+static uint8_t appliedCount = 0;       // Results applied since the last reset
+static uint32_t firstGuess = DICTIONARY_INVALID_WORD;
+static uint8_t firstPattern = 0;
+
+/*-----------------------------------------------------------
+Local Function Prototypes
+------------------------------------------------------------*/
+
+/*
+* Description:
+*      Keeps the candidates that are also in the mask
+*
+* Arguments:
+*     const uint32_t *mask: The mask
+*
+* Returns:
+*      None
+*/
+static void keepCandidates(const uint32_t *mask);
+
+
+/*
+* Description:
+*      Drops the candidates that are in the mask
+*
+* Arguments:
+*     const uint32_t *mask: The mask
+*
+* Returns:
+*      None
+*/
+static void dropCandidates(const uint32_t *mask);
+
+
+/*
+* Description:
+*      Computes the result of a guess against an answer as a pattern number
+*      Same rules as evaluateGuess, without the string handling
+*
+* Arguments:
+*     uint32_t guess: The packed guess
+*     uint32_t answer: The packed answer
+*
+* Returns:
+*      uint8_t: The pattern, 0 to WORD_SOLVER_PATTERN_COUNT - 1
+*/
+static uint8_t resultPattern(uint32_t guess, uint32_t answer);
+
+/*-----------------------------------------------------------
+Functions
+------------------------------------------------------------*/
+
+static void keepCandidates(const uint32_t *mask)
+{
+    for(uint32_t word = 0; word < bitsetWords; word++)
+    {
+        candidates[word] &= mask[word];
+    }
+}
+
+static void dropCandidates(const uint32_t *mask)
+{
+    for(uint32_t word = 0; word < bitsetWords; word++)
+    {
+        candidates[word] &= ~mask[word];
+    }
+}
+
+static uint8_t resultPattern(uint32_t guess, uint32_t answer)
+{
+    static const uint8_t powersOfThree[GUESS_LETTER_COUNT] = {1, 3, 9, 27, 81};
+    uint8_t guessLetters[GUESS_LETTER_COUNT];
+    uint8_t answerLetters[GUESS_LETTER_COUNT];
+    uint8_t usedAnswerLetters = 0;  // Bit per answer position already matched
+    uint8_t pattern = 0;
+
+    for(uint8_t pos = 0; pos < GUESS_LETTER_COUNT; pos++)
+    {
+        guessLetters[pos] = PACKED_LETTER(guess, pos);
+        answerLetters[pos] = PACKED_LETTER(answer, pos);
+
+        if(guessLetters[pos] == answerLetters[pos])
+        {
+            usedAnswerLetters |= 1 << pos;
+            pattern += 2 * powersOfThree[pos];
+        }
+    }
+
+    // Each unmatched answer letter marks at most one misplaced guess letter, left to right
+    for(uint8_t pos = 0; pos < GUESS_LETTER_COUNT; pos++)
+    {
+        if(guessLetters[pos] == answerLetters[pos])
+        {
+            continue;
+        }
+
+        for(uint8_t other = 0; other < GUESS_LETTER_COUNT; other++)
+        {
+            if(!(usedAnswerLetters & (1 << other)) && answerLetters[other] == guessLetters[pos])
+            {
+                usedAnswerLetters |= 1 << other;
+                pattern += powersOfThree[pos];
+                break;
+            }
+        }
+    }
+
+    return pattern;
+}
+
+bool wordSolverInit(void)
+{
+    uint8_t letterCounts[LETTER_COUNT];
+    uint32_t packed;
+    uint32_t bit;
+    uint8_t letter;
+
+    free(candidates);
+    candidates = NULL;
+
+    answerCount = wordDictionaryAnswerCount();
+    bitsetWords = (answerCount + 31) / 32;
+
+    if(answerCount == 0)
+    {
+        return false;
+    }
+
+    // One block for the candidates and every mask
+    candidates = calloc(bitsetWords * (1 + (GUESS_LETTER_COUNT + MAX_LETTER_REPEAT) * LETTER_COUNT), sizeof(uint32_t));
+
+    if(candidates == NULL)
+    {
+        answerCount = 0;
+        return false;
+    }
+
+    positionMasks = candidates + bitsetWords;
+    countMasks = positionMasks + GUESS_LETTER_COUNT * LETTER_COUNT * bitsetWords;
+
+    for(uint32_t answer = 0; answer < answerCount; answer++)
+    {
+        packed = wordDictionaryGetAnswer(answer);
+        bit = 1u << (answer % 32);
+        memset(letterCounts, 0, sizeof(letterCounts));
+
+        for(uint8_t pos = 0; pos < GUESS_LETTER_COUNT; pos++)
+        {
+            letter = PACKED_LETTER(packed, pos);
+            POSITION_MASK(pos, letter)[answer / 32] |= bit;
+
+            if(letterCounts[letter] < MAX_LETTER_REPEAT)
+            {
+                letterCounts[letter]++;
+                COUNT_MASK(letterCounts[letter], letter)[answer / 32] |= bit;
+            }
+        }
+    }
+
+    wordSolverReset();
+
+    return true;
+}
+
+void wordSolverReset(void)
+{
+    if(candidates == NULL)
+    {
+        return;
+    }
+
+    memset(candidates, 0xFF, bitsetWords * sizeof(uint32_t));
+    appliedCount = 0;
+    firstGuess = DICTIONARY_INVALID_WORD;
+
+    // Clear the bits past the last answer
+    if(answerCount % 32 != 0)
+    {
+        candidates[bitsetWords - 1] = (1u << (answerCount % 32)) - 1;
+    }
+}
+
+bool wordSolverApply(const char *guess, const char *result)
+{
+    uint8_t minCounts[LETTER_COUNT] = {0};
+    bool isCountExact[LETTER_COUNT] = {0};
+    uint8_t letters[GUESS_LETTER_COUNT];
+    uint8_t letter;
+    uint8_t pattern = 0;
+    uint8_t digit = 1;
+
+    if(candidates == NULL || guess == NULL || result == NULL)
+    {
+        return false;
+    }
+
+    for(uint8_t pos = 0; pos < GUESS_LETTER_COUNT; pos++)
+    {
+        letters[pos] = LETTER_INDEX(guess[pos]);
+
+        if(letters[pos] >= LETTER_COUNT)
+        {
+            return false;
+        }
+
+        // Every '+' and 'x' is one more of the letter, a '-' means there are no more than that
+        switch(result[pos])
+        {
+            case RESULT_CORRECT:
+                pattern += 2 * digit;
+                minCounts[letters[pos]]++;
+                break;
+            case RESULT_SWAP:
+                pattern += digit;
+                minCounts[letters[pos]]++;
+                break;
+            case RESULT_WRONG:
+                isCountExact[letters[pos]] = true;
+                break;
+            default:
+                return false;
+        }
+
+        digit *= 3;
+    }
+
+    if(appliedCount++ == 0)
+    {
+        firstGuess = wordDictionaryPack(guess);
+        firstPattern = pattern;
+    }
+
+    // The letter is at this position, or it is not
+    for(uint8_t pos = 0; pos < GUESS_LETTER_COUNT; pos++)
+    {
+        if(result[pos] == RESULT_CORRECT)
+        {
+            keepCandidates(POSITION_MASK(pos, letters[pos]));
+        }
+        else
+        {
+            dropCandidates(POSITION_MASK(pos, letters[pos]));
+        }
+    }
+
+    // How many of each guessed letter the answer has
+    for(uint8_t pos = 0; pos < GUESS_LETTER_COUNT; pos++)
+    {
+        letter = letters[pos];
+
+        if(minCounts[letter] > 0 && minCounts[letter] <= MAX_LETTER_REPEAT)
+        {
+            keepCandidates(COUNT_MASK(minCounts[letter], letter));
+        }
+
+        if(isCountExact[letter] && minCounts[letter] < MAX_LETTER_REPEAT)
+        {
+            dropCandidates(COUNT_MASK(minCounts[letter] + 1, letter));
+        }
+
+        // Only once per letter
+        minCounts[letter] = 0;
+        isCountExact[letter] = false;
+    }
+
+    return true;
+}
+
+uint32_t wordSolverCandidateCount(void)
+{
+    uint32_t count = 0;
+
+    if(candidates == NULL)
+    {
+        return 0;
+    }
+
+    for(uint32_t word = 0; word < bitsetWords; word++)
+    {
+        count += __builtin_popcount(candidates[word]);
+    }
+
+    return count;
+}
+
+uint8_t wordSolverAppliedCount(void)
+{
+    return appliedCount;
+}
+
+bool wordSolverFirstResult(uint32_t *guess, uint8_t *pattern)
+{
+    if(appliedCount == 0 || guess == NULL || pattern == NULL)
+    {
+        return false;
+    }
+
+    *guess = firstGuess;
+    *pattern = firstPattern;
+
+    return true;
+}
+
+uint32_t wordSolverListCandidates(uint32_t *positions, uint32_t maxCount)
+{
+    uint32_t count = 0;
+    uint32_t bits;
+
+    if(candidates == NULL || positions == NULL)
+    {
+        return 0;
+    }
+
+    for(uint32_t word = 0; word < bitsetWords && count < maxCount; word++)
+    {
+        // Walk the set bits only, lowest first
+        for(bits = candidates[word]; bits != 0 && count < maxCount; bits &= bits - 1)
+        {
+            positions[count++] = word * 32 + __builtin_ctz(bits);
+        }
+    }
+
+    return count;
+}
+
+float wordSolverScoreGuess(uint32_t guess, const uint32_t *answers, uint32_t answerCount)
+{
+    uint16_t patternCounts[WORD_SOLVER_PATTERN_COUNT] = {0};
+    float weightedLog = 0;
+
+    if(answers == NULL || answerCount == 0)
+    {
+        return 0;
+    }
+
+    for(uint32_t answer = 0; answer < answerCount; answer++)
+    {
+        patternCounts[resultPattern(guess, answers[answer])]++;
+    }
+
+    // Entropy of the pattern distribution, log2(n) - sum(c * log2(c)) / n
+    for(uint16_t pattern = 0; pattern < WORD_SOLVER_PATTERN_COUNT; pattern++)
+    {
+        if(patternCounts[pattern] > 1)
+        {
+            weightedLog += patternCounts[pattern] * log2f(patternCounts[pattern]);
+        }
+    }
+
+    // A guess that can be the answer also has a 1 in n chance to win outright
+    return log2f(answerCount) - weightedLog / answerCount + (patternCounts[PATTERN_ALL_CORRECT] > 0 ? 1.0f / answerCount : 0);
+}
@@ -0,0 +1,135 @@
+/*
+ Lookup speed of the word dictionary, binary search over the whole list vs
+ the first-two-letter index, with and without the bloom filter in front,
+ for words in the list and for typos. Also measures the filter's false
+ positive rate on random non-words.
+
+ Usage: dictionary_bench [dictionary.bin]
+*/
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "wordDictionary.h"
+
+#define QUERY_COUNT     4096
+#define ROUNDS          200
+#define FP_SAMPLE_COUNT 1000000
+
+typedef struct {
+    const char *name;
+    bool use_index;
+    bool use_bloom;
+} search_mode_t;
+
+static const search_mode_t modes[] = {
+    {"binary search", false, false},
+    {"first-two-letter index", true, false},
+    {"bloom + index", true, true},
+};
+
+static uint32_t image[64 * 1024];   // Big enough for the dict partition
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static uint32_t xorshift(uint32_t *state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+// Words from the list with one letter changed, most of them are not words
+static void make_typos(char queries[][DICTIONARY_WORD_LENGTH + 1], uint32_t *seed) {
+    for (int i = 0; i < QUERY_COUNT; i++) {
+        wordDictionaryUnpack(wordDictionaryGet(xorshift(seed) % wordDictionarySize()), queries[i]);
+        queries[i][xorshift(seed) % DICTIONARY_WORD_LENGTH] = 'a' + xorshift(seed) % 26;
+    }
+}
+
+static void make_hits(char queries[][DICTIONARY_WORD_LENGTH + 1], uint32_t *seed) {
+    for (int i = 0; i < QUERY_COUNT; i++) {
+        wordDictionaryUnpack(wordDictionaryGet(xorshift(seed) % wordDictionarySize()), queries[i]);
+    }
+}
+
+static void run(const char *label, char queries[][DICTIONARY_WORD_LENGTH + 1]) {
+    int found = 0;
+
+    double start = now_ns();
+    for (int round = 0; round < ROUNDS; round++) {
+        for (int i = 0; i < QUERY_COUNT; i++) {
+            found += wordDictionaryContains(queries[i]);
+        }
+    }
+    double per_lookup = (now_ns() - start) / ((double)ROUNDS * QUERY_COUNT);
+
+    printf("%-18s %6.1f ns/lookup  %5.1f%% found\n", label, per_lookup, 100.0 * found / ((double)ROUNDS * QUERY_COUNT));
+}
+
+int main(int argc, char **argv) {
+    static char hits[QUERY_COUNT][DICTIONARY_WORD_LENGTH + 1];
+    static char typos[QUERY_COUNT][DICTIONARY_WORD_LENGTH + 1];
+    const char *path = argc > 1 ? argv[1] : DICTIONARY_IMAGE_PATH;
+    uint32_t seed = 0x5EED;
+
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) {
+        perror(path);
+        return 1;
+    }
+    size_t size = fread(image, 1, sizeof(image), file);
+    fclose(file);
+
+    if (!wordDictionaryAttach(image, size)) {
+        fprintf(stderr, "%s: not a valid dictionary image\n", path);
+        return 1;
+    }
+
+    // Every search path has to find every word in the list (no false negatives)
+    for (uint32_t i = 0; i < wordDictionarySize(); i++) {
+        char word[DICTIONARY_WORD_LENGTH + 1];
+        wordDictionaryUnpack(wordDictionaryGet(i), word);
+        for (size_t mode = 0; mode < sizeof(modes) / sizeof(modes[0]); mode++) {
+            wordDictionarySetIndexEnabled(modes[mode].use_index);
+            wordDictionarySetBloomEnabled(modes[mode].use_bloom);
+            if (!wordDictionaryContains(word)) {
+                fprintf(stderr, "\"%s\" not found (%s)\n", word, modes[mode].name);
+                return 1;
+            }
+        }
+    }
+
+    make_hits(hits, &seed);
+    make_typos(typos, &seed);
+
+    printf("%u words, %d lookups per case\n", wordDictionarySize(), ROUNDS * QUERY_COUNT);
+    for (size_t mode = 0; mode < sizeof(modes) / sizeof(modes[0]); mode++) {
+        wordDictionarySetIndexEnabled(modes[mode].use_index);
+        wordDictionarySetBloomEnabled(modes[mode].use_bloom);
+        printf("%s\n", modes[mode].name);
+        run("  words", hits);
+        run("  typos", typos);
+    }
+
+    // False positives: random letter strings that are not words but pass the filter
+    wordDictionarySetBloomEnabled(false);
+    int non_words = 0, passed = 0;
+    for (int i = 0; i < FP_SAMPLE_COUNT; i++) {
+        char word[DICTIONARY_WORD_LENGTH + 1] = {0};
+        for (int pos = 0; pos < DICTIONARY_WORD_LENGTH; pos++) {
+            word[pos] = 'a' + xorshift(&seed) % 26;
+        }
+        if (!wordDictionaryContains(word)) {
+            non_words++;
+            passed += wordDictionaryMayContain(word);
+        }
+    }
+    printf("bloom false positive rate: %.4f%% (%d of %d non-words)\n", 100.0 * passed / non_words, passed, non_words);
+    return 0;
+}
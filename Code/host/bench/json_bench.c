@@ -0,0 +1,129 @@
+/*
+ Compares the zero-allocation field extractor against the cJSON paths used
+ by api_client.c (plain heap and arena hooks), for parse time and heap use
+ per response.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "cJSON.h"
+#include "cjson_arena.h"
+#include "json_extract.h"
+
+#define ITERATIONS 200000
+
+typedef struct {
+    const char *name;
+    const char *json;
+    const char *field;
+} sample_t;
+
+// Same shapes as the /word and /guess responses
+static const sample_t samples[] = {
+    {"word",  "{\"word\":\"crane\",\"timezone\":\"UTC + 8\",\"date\":\"2024-11-20\"}", "word"},
+    {"guess", "{\"guess\":\"trace\",\"result\":\"x+x-+\",\"isWordInList\":true,\"attempts\":[1,2,3]}", "result"},
+};
+
+static size_t heap_allocs;
+static size_t heap_bytes;
+static size_t heap_live;
+static size_t heap_peak;
+
+static void *counting_malloc(size_t size) {
+    size_t *block = malloc(size + sizeof(size_t));
+    if (block == NULL) {
+        return NULL;
+    }
+    *block = size;
+    heap_allocs++;
+    heap_bytes += size;
+    heap_live += size;
+    if (heap_live > heap_peak) {
+        heap_peak = heap_live;
+    }
+    return block + 1;
+}
+
+static void counting_free(void *ptr) {
+    if (ptr != NULL) {
+        size_t *block = (size_t *)ptr - 1;
+        heap_live -= *block;
+        free(block);
+    }
+}
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static int parse_cjson(const sample_t *sample, char *out, size_t out_size) {
+    cJSON *root = cJSON_ParseWithLength(sample->json, strlen(sample->json));
+    cJSON *item = cJSON_GetObjectItem(root, sample->field);
+    int ok = cJSON_IsString(item) && item->valuestring != NULL;
+    if (ok) {
+        strncpy(out, item->valuestring, out_size - 1);
+        out[out_size - 1] = '\0';
+    }
+    cJSON_Delete(root);
+    return ok;
+}
+
+static int parse_cjson_arena(const sample_t *sample, char *out, size_t out_size) {
+    cjson_arena_begin(0);
+    cJSON *root = cJSON_ParseWithLength(sample->json, strlen(sample->json));
+    cJSON *item = cJSON_GetObjectItem(root, sample->field);
+    int ok = cJSON_IsString(item) && item->valuestring != NULL;
+    if (ok) {
+        strncpy(out, item->valuestring, out_size - 1);
+        out[out_size - 1] = '\0';
+    }
+    if (cjson_arena_used_heap()) {
+        cJSON_Delete(root);
+    }
+    cjson_arena_end();
+    return ok;
+}
+
+static int parse_extractor(const sample_t *sample, char *out, size_t out_size) {
+    return json_extract_string(sample->json, strlen(sample->json), sample->field, out, out_size);
+}
+
+static void run(const char *label, const sample_t *sample, int (*parse)(const sample_t *, char *, size_t)) {
+    char value[16];
+    volatile int sink = 0;
+
+    heap_allocs = heap_bytes = heap_live = heap_peak = 0;
+    parse(sample, value, sizeof(value));
+    size_t allocs = heap_allocs, bytes = heap_bytes, peak = heap_peak;
+
+    double start = now_ns();
+    for (int i = 0; i < ITERATIONS; i++) {
+        sink += parse(sample, value, sizeof(value));
+    }
+    double per_call = (now_ns() - start) / ITERATIONS;
+
+    printf("%-6s %-12s %8.1f ns/parse  %3zu allocs  %4zu bytes  %4zu peak  -> \"%s\"\n",
+           sample->name, label, per_call, allocs, bytes, peak, value);
+    (void)sink;
+}
+
+int main(void) {
+    cJSON_Hooks hooks = { .malloc_fn = counting_malloc, .free_fn = counting_free };
+
+    printf("%d iterations per case\n", ITERATIONS);
+    for (size_t i = 0; i < sizeof(samples) / sizeof(samples[0]); i++) {
+        cJSON_InitHooks(&hooks);
+        run("cJSON", &samples[i], parse_cjson);
+
+        cjson_arena_init();
+        run("cJSON+arena", &samples[i], parse_cjson_arena);
+        printf("%-6s %-12s arena peak %zu of %d bytes, heap fallback: %s\n", samples[i].name, "",
+               cjson_arena_peak(0), CJSON_ARENA_SIZE, cjson_arena_used_heap() ? "yes" : "no");
+
+        run("extractor", &samples[i], parse_extractor);
+    }
+    return 0;
+}
@@ -0,0 +1,176 @@
+/*
+ Candidate filtering speed of the bitset solver. Plays random games against
+ random answers with random guesses from the word list, checks every step
+ against a plain scan with evaluateGuess (the remaining candidates must be
+ exactly the answers that give the same result), and times the filtering.
+
+ Then times the hint search (scoring every word against the answers left) on
+ one core, for the first guess and for the sets left after one and two
+ guesses. The device splits the same work across both cores.
+
+ Usage: solver_bench [dictionary.bin]
+*/
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "wordDictionary.h"
+#include "guessEvaluator.h"
+#include "wordSolver.h"
+
+#define GAME_COUNT      2000
+#define GUESSES_PER_GAME 6
+#define HINT_GAME_COUNT 20
+
+static uint32_t image[64 * 1024];   // Big enough for the dict partition
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static uint32_t xorshift(uint32_t *state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+// Reference: answers that give the same result for every guess so far
+static uint32_t scan_candidates(char guesses[][DICTIONARY_WORD_LENGTH + 1], char results[][DICTIONARY_WORD_LENGTH + 1],
+                                int guess_count, uint32_t *positions) {
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < wordDictionaryAnswerCount(); i++) {
+        char answer[DICTIONARY_WORD_LENGTH + 1];
+        char result[DICTIONARY_WORD_LENGTH + 1];
+        bool fits = true;
+        wordDictionaryUnpack(wordDictionaryGetAnswer(i), answer);
+        for (int g = 0; g < guess_count && fits; g++) {
+            evaluateGuess(guesses[g], answer, result);
+            fits = strcmp(result, results[g]) == 0;
+        }
+        if (fits) {
+            positions[count++] = i;
+        }
+    }
+    return count;
+}
+
+// Scores every word against the candidates left, like wordHintSuggest on one core
+static double time_hint(char *best_word, uint32_t *answer_count) {
+    static uint32_t answers[8192];
+    uint32_t best = 0;
+    float best_score = -1;
+
+    *answer_count = wordSolverListCandidates(answers, sizeof(answers) / sizeof(answers[0]));
+    for (uint32_t i = 0; i < *answer_count; i++) {
+        answers[i] = wordDictionaryGetAnswer(answers[i]);
+    }
+
+    double start = now_ns();
+    for (uint32_t guess = 0; guess < wordDictionarySize(); guess++) {
+        float score = wordSolverScoreGuess(wordDictionaryGet(guess), answers, *answer_count);
+        if (score > best_score) {
+            best_score = score;
+            best = guess;
+        }
+    }
+    double elapsed_ms = (now_ns() - start) / 1e6;
+
+    wordDictionaryUnpack(wordDictionaryGet(best), best_word);
+    return elapsed_ms;
+}
+
+int main(int argc, char **argv) {
+    const char *path = argc > 1 ? argv[1] : DICTIONARY_IMAGE_PATH;
+    uint32_t seed = 0x5EED;
+    static uint32_t expected[8192], actual[8192];
+    double apply_ns = 0, count_ns = 0;
+    uint64_t applied = 0, remaining[GUESSES_PER_GAME] = {0};
+
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) {
+        perror(path);
+        return 1;
+    }
+    size_t size = fread(image, 1, sizeof(image), file);
+    fclose(file);
+
+    if (!wordDictionaryAttach(image, size) || !wordSolverInit()) {
+        fprintf(stderr, "%s: not a valid dictionary image with answers\n", path);
+        return 1;
+    }
+
+    for (int game = 0; game < GAME_COUNT; game++) {
+        char target[DICTIONARY_WORD_LENGTH + 1];
+        char guesses[GUESSES_PER_GAME][DICTIONARY_WORD_LENGTH + 1];
+        char results[GUESSES_PER_GAME][DICTIONARY_WORD_LENGTH + 1];
+
+        wordDictionaryUnpack(wordDictionaryGetAnswer(xorshift(&seed) % wordDictionaryAnswerCount()), target);
+        wordSolverReset();
+
+        for (int g = 0; g < GUESSES_PER_GAME; g++) {
+            wordDictionaryUnpack(wordDictionaryGet(xorshift(&seed) % wordDictionarySize()), guesses[g]);
+            evaluateGuess(guesses[g], target, results[g]);
+
+            double start = now_ns();
+            wordSolverApply(guesses[g], results[g]);
+            apply_ns += now_ns() - start;
+
+            start = now_ns();
+            uint32_t count = wordSolverCandidateCount();
+            count_ns += now_ns() - start;
+            applied++;
+            remaining[g] += count;
+
+            uint32_t expected_count = scan_candidates(guesses, results, g + 1, expected);
+            uint32_t actual_count = wordSolverListCandidates(actual, sizeof(actual) / sizeof(actual[0]));
+            if (count != expected_count || actual_count != expected_count ||
+                memcmp(expected, actual, expected_count * sizeof(expected[0])) != 0) {
+                fprintf(stderr, "Game %d guess %d (%s %s, target %s): %u candidates, expected %u\n",
+                        game, g, guesses[g], results[g], target, count, expected_count);
+                return 1;
+            }
+        }
+    }
+
+    printf("%u answers, %d games of %d random guesses, all matched a full scan\n",
+           wordDictionaryAnswerCount(), GAME_COUNT, GUESSES_PER_GAME);
+    printf("apply result     %8.1f ns\n", apply_ns / applied);
+    printf("count candidates %8.1f ns\n", count_ns / applied);
+    for (int g = 0; g < GUESSES_PER_GAME; g++) {
+        printf("after guess %d    %8.1f candidates on average\n", g + 1, (double)remaining[g] / GAME_COUNT);
+    }
+
+    char best[DICTIONARY_WORD_LENGTH + 1];
+    uint32_t answer_count;
+    wordSolverReset();
+    double first_ms = time_hint(best, &answer_count);
+    printf("hint, first guess  %8.1f ms for %u answers x %u words (%s)\n", first_ms, answer_count, wordDictionarySize(), best);
+
+    // Mid-game: the hint's own first suggestion, then a random word
+    for (int guesses = 1; guesses <= 2; guesses++) {
+        double total_ms = 0;
+        uint64_t total_answers = 0;
+        for (int game = 0; game < HINT_GAME_COUNT; game++) {
+            char target[DICTIONARY_WORD_LENGTH + 1], guess[DICTIONARY_WORD_LENGTH + 1], result[DICTIONARY_WORD_LENGTH + 1];
+            wordDictionaryUnpack(wordDictionaryGetAnswer(xorshift(&seed) % wordDictionaryAnswerCount()), target);
+            wordSolverReset();
+            evaluateGuess(best, target, result);
+            wordSolverApply(best, result);
+            if (guesses == 2) {
+                wordDictionaryUnpack(wordDictionaryGet(xorshift(&seed) % wordDictionarySize()), guess);
+                evaluateGuess(guess, target, result);
+                wordSolverApply(guess, result);
+            }
+            char suggestion[DICTIONARY_WORD_LENGTH + 1];
+            total_ms += time_hint(suggestion, &answer_count);
+            total_answers += answer_count;
+        }
+        printf("hint, after %d      %8.2f ms on average for %.1f answers\n", guesses,
+               total_ms / HINT_GAME_COUNT, (double)total_answers / HINT_GAME_COUNT);
+    }
+    return 0;
+}
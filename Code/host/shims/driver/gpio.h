@@ -0,0 +1,4 @@
+// Host stand-in for ESP-IDF's GPIO driver, enough for the max7219 header
+#pragma once
+
+typedef int gpio_num_t;
@@ -0,0 +1,37 @@
+// Host stand-in for ESP-IDF's esp_log.h
+// Errors go to stderr, everything else is dropped so the simulator runs at full speed
+#pragma once
+
+#include <stdarg.h>
+#include <stdio.h>
+
+typedef enum {
+    ESP_LOG_NONE,
+    ESP_LOG_ERROR,
+    ESP_LOG_WARN,
+    ESP_LOG_INFO,
+    ESP_LOG_DEBUG,
+    ESP_LOG_VERBOSE
+} esp_log_level_t;
+
+static inline void host_log_error(const char *tag, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    fprintf(stderr, "E %s: ", tag);
+    vfprintf(stderr, format, args);
+    fputc('\n', stderr);
+    va_end(args);
+}
+
+static inline void host_log_drop(const char *tag, const char *format, ...) {
+    (void)tag;
+    (void)format;
+}
+
+#define ESP_LOGE(tag, format, ...) host_log_error(tag, format, ##__VA_ARGS__)
+#define ESP_LOGW(tag, format, ...) host_log_drop(tag, format, ##__VA_ARGS__)
+#define ESP_LOGI(tag, format, ...) host_log_drop(tag, format, ##__VA_ARGS__)
+#define ESP_LOGD(tag, format, ...) host_log_drop(tag, format, ##__VA_ARGS__)
+#define ESP_LOGV(tag, format, ...) host_log_drop(tag, format, ##__VA_ARGS__)
+
+#define ESP_LOG_BUFFER_HEXDUMP(tag, buffer, length, level) do { (void)(buffer); (void)(length); } while (0)
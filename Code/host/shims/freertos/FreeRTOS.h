@@ -0,0 +1,20 @@
+// Host stand-in for FreeRTOS.h, ticks at the device rate (CONFIG_FREERTOS_HZ in
+// sdkconfig.defaults, passed in by CMakeLists.txt) so ms to tick rounding matches
+#pragma once
+
+#include <stdint.h>
+
+#ifndef configTICK_RATE_HZ
+#error "configTICK_RATE_HZ must be set to the device's CONFIG_FREERTOS_HZ"
+#endif
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+
+#define pdTRUE  1
+#define pdFALSE 0
+#define pdPASS  pdTRUE
+
+#define portMAX_DELAY       UINT32_MAX
+#define portTICK_PERIOD_MS  ((TickType_t)1000 / configTICK_RATE_HZ)
+#define pdMS_TO_TICKS(ms)   ((TickType_t)(((TickType_t)(ms) * (TickType_t)configTICK_RATE_HZ) / (TickType_t)1000U))
@@ -0,0 +1,15 @@
+// Host stand-in for FreeRTOS task.h
+// Nothing waits on the host, delays only move the simulated tick count on
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+
+extern TickType_t hostTickCount;
+
+static inline void vTaskDelay(TickType_t ticks) {
+    hostTickCount += ticks;
+}
+
+static inline TickType_t xTaskGetTickCount(void) {
+    return hostTickCount;
+}
@@ -0,0 +1,481 @@
+/*
+ Plays scripted games against the game core (wordGuessCore.c) on the host,
+ through the real matrixDisplay code on top of a max7219 stub. Each game
+ picks a random answer, then guesses random words that still fit every
+ result (from wordSolver) until it wins or runs out of guesses. Every word
+ is typed the way a player would: cursor to the letter, SELECT, turn the
+ carousel the short way round, SELECT, and GUESS once the row is done.
+
+ Checks on every guess that the row on the display is the word typed and
+ that the game ends when and how it should, then reports games per second,
+ button presses per game and the display and LED traffic they cause.
+ The same games are played twice, with the carousel showing every letter
+ and with it skipping the letters the results ruled out, then once more
+ opening the guess history after every guess: each earlier row must come
+ back as typed and leaving must put both displays back exactly. That run
+ also reboots after every guess (the display is wiped and the core starts
+ over) and resumes from the last checkpoint given to saveGame: the board
+ must come back the same and the games must end exactly as in the run
+ before. Then RIGHT is held
+ on the carousel from A to Z, stepping on the hold curve of the device
+ (wordGuessCoreHoldDelay), and the time it takes on the simulated clock
+ is reported. Last, a word missing from the word list is guessed: it must
+ be refused without using a guess or asking the api. A listed word is
+ guessed after it, and leaving with EXIT must clear the checkpoint.
+
+ Usage: game_sim [games] [dictionary.bin]
+*/
+#include <ctype.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "matrixDisplay.h"
+#include "wordDictionary.h"
+#include "guessEvaluator.h"
+#include "wordSolver.h"
+#include "wordGuessCore.h"
+#include "freertos/task.h"
+#include "max7219_stub.h"
+
+#define DEFAULT_GAME_COUNT  10000
+#define MAX_GUESSES         6
+#define CAROUSEL_LETTERS    26
+#define NOT_A_WORD          "qzxvj"
+#define SIM_DATE            20261019    // Every game is played on the same day
+
+static uint32_t image[64 * 1024];   // Big enough for the dict partition
+static uint32_t candidates[8192];
+
+static char answer[DICTIONARY_WORD_LENGTH + 1];
+static char typed[MAX_GUESSES][DICTIONARY_WORD_LENGTH + 1];
+static uint64_t presses, led_writes, api_checks, history_rows, resumes;
+static uint8_t checkpoint[WORD_GUESS_CHECKPOINT_MAX_SIZE];
+static size_t checkpoint_size;
+static uint32_t seed = 0x5EED;
+static bool is_browsing;
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static uint32_t xorshift(uint32_t *state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+/*---- Backend ----*/
+
+static void sim_set_button_leds(uint8_t leds) {
+    (void)leds;
+    led_writes += 4;    // One gpio_set_level per button on the device
+}
+
+static bool sim_get_word_to_guess(char *word, int word_size) {
+    if (word_size <= DICTIONARY_WORD_LENGTH) {
+        return false;
+    }
+    memcpy(word, answer, DICTIONARY_WORD_LENGTH + 1);
+    return true;
+}
+
+static bool sim_check_guess(const char *guess, char *result, int result_size) {
+    (void)guess;
+    (void)result;
+    (void)result_size;
+    api_checks++;       // The answer is always known, so this should not happen
+    return false;
+}
+
+static void sim_show_hint(void) {
+}
+
+static void sim_delay_ms(uint32_t ms) {
+    (void)ms;
+}
+
+static bool sim_get_date(uint32_t *date_key) {
+    *date_key = SIM_DATE;
+    return true;
+}
+
+static void sim_save_game(const void *record, size_t size) {
+    if (size > sizeof(checkpoint)) {
+        fprintf(stderr, "Checkpoint of %zu bytes is too big\n", size);
+        exit(1);
+    }
+    if (size > 0) {
+        memcpy(checkpoint, record, size);
+    }
+    checkpoint_size = size;
+}
+
+static const wordGuessBackend_t sim_backend = {
+    .setButtonLeds = sim_set_button_leds,
+    .getWordToGuess = sim_get_word_to_guess,
+    .checkGuess = sim_check_guess,
+    .showHint = sim_show_hint,
+    .delayMs = sim_delay_ms,
+    .getDate = sim_get_date,
+    .saveGame = sim_save_game,
+};
+
+/*---- Player ----*/
+
+static bool press(wordGuessEvent_t event) {
+    presses++;
+    return wordGuessCoreHandleEvent(event);
+}
+
+// The device stops taking presses once a game is exited, each game starts from a reset like a reboot
+static void start_game(void) {
+    wordGuessCoreReset();
+    press(WORD_GUESS_EVENT_SELECT);
+}
+
+// Moves forward steps round a ring of the given size, LEFT instead of RIGHT when that is shorter
+static void step_round(int forward, int ring) {
+    if (forward <= ring / 2) {
+        for (int step = 0; step < forward; step++) {
+            press(WORD_GUESS_EVENT_RIGHT);
+        }
+    } else {
+        for (int step = 0; step < ring - forward; step++) {
+            press(WORD_GUESS_EVENT_LEFT);
+        }
+    }
+}
+
+static bool type_word(const char *word) {
+    char row[DICTIONARY_WORD_LENGTH + 1];
+
+    for (int pos = 0; pos < DICTIONARY_WORD_LENGTH; pos++) {
+        char letter = toupper((unsigned char)word[pos]);
+
+        getWord(row, sizeof(row));
+        if (row[pos] == letter) {
+            continue;
+        }
+
+        // Every press moves the cursor, or the carousel under it, by one
+        step_round((pos - getCursorPos() + CASCADE_SIZE) % CASCADE_SIZE, CASCADE_SIZE);
+        press(WORD_GUESS_EVENT_SELECT);
+        if (wordGuessCoreGetState() != LETTER_SELECTION) {
+            return false;
+        }
+
+        // Turn the short way round the full alphabet, the carousel may skip letters on the way
+        int forward = (letter - getCharAtCursor() + CAROUSEL_LETTERS) % CAROUSEL_LETTERS;
+        wordGuessEvent_t turn = forward <= CAROUSEL_LETTERS / 2 ? WORD_GUESS_EVENT_RIGHT : WORD_GUESS_EVENT_LEFT;
+        for (int step = 0; step < CAROUSEL_LETTERS && getCharAtCursor() != letter; step++) {
+            press(turn);
+        }
+        if (getCharAtCursor() != letter) {
+            return false;
+        }
+        press(WORD_GUESS_EVENT_SELECT);
+    }
+
+    getWord(row, sizeof(row));
+    return strncasecmp(row, word, DICTIONARY_WORD_LENGTH) == 0;
+}
+
+// Opens the history, steps back through every guess so far and leaves it again
+static bool browse_history(int guess_count, wordGuessEvent_t open) {
+    uint64_t saved[NUM_DISPLAYS][CASCADE_SIZE], restored[NUM_DISPLAYS][CASCADE_SIZE];
+    char row[DICTIONARY_WORD_LENGTH + 1];
+    wordGuessGameStates_t state = wordGuessCoreGetState();
+
+    getDisplayState(UPPER_DISPLAY, saved[UPPER_DISPLAY]);
+    getDisplayState(LOWER_DISPLAY, saved[LOWER_DISPLAY]);
+
+    press(open);
+    for (int guess = guess_count - 1; guess >= 0; guess--) {
+        getWord(row, sizeof(row));
+        if (wordGuessCoreGetState() != HISTORY || strncasecmp(row, typed[guess], DICTIONARY_WORD_LENGTH) != 0) {
+            fprintf(stderr, "%s: history row %d shows %s, expected %s\n", answer, guess, row, typed[guess]);
+            return false;
+        }
+        history_rows++;
+        press(WORD_GUESS_EVENT_LEFT);
+    }
+    press(WORD_GUESS_EVENT_EXIT);
+
+    getDisplayState(UPPER_DISPLAY, restored[UPPER_DISPLAY]);
+    getDisplayState(LOWER_DISPLAY, restored[LOWER_DISPLAY]);
+    if (wordGuessCoreGetState() != state || memcmp(saved, restored, sizeof(saved)) != 0) {
+        fprintf(stderr, "%s: the board did not come back after the history\n", answer);
+        return false;
+    }
+    return true;
+}
+
+// Wipes the display and the core like a reset, then resumes from the checkpoint
+static bool reboot_and_resume(int guess_count) {
+    uint64_t saved[NUM_DISPLAYS][CASCADE_SIZE], restored[NUM_DISPLAYS][CASCADE_SIZE];
+
+    getDisplayState(UPPER_DISPLAY, saved[UPPER_DISPLAY]);
+    getDisplayState(LOWER_DISPLAY, saved[LOWER_DISPLAY]);
+
+    if (wordGuessCoreCheckpointDate(checkpoint, checkpoint_size) != SIM_DATE) {
+        fprintf(stderr, "%s: checkpoint after guess %d is not dated today\n", answer, guess_count);
+        return false;
+    }
+
+    display_init();
+    if (checkpoint_size == 0 || wordGuessCoreInit(&sim_backend) != ESP_OK ||
+        wordGuessCoreResume(checkpoint, checkpoint_size) != ESP_OK) {
+        fprintf(stderr, "%s: could not resume after guess %d\n", answer, guess_count);
+        return false;
+    }
+
+    getDisplayState(UPPER_DISPLAY, restored[UPPER_DISPLAY]);
+    getDisplayState(LOWER_DISPLAY, restored[LOWER_DISPLAY]);
+    if (wordGuessCoreGetState() != LETTER_EDIT || wordGuessCoreGetGuessCount() != guess_count ||
+        memcmp(saved, restored, sizeof(saved)) != 0) {
+        fprintf(stderr, "%s: resumed board after guess %d is not the one left\n", answer, guess_count);
+        return false;
+    }
+    resumes++;
+    return true;
+}
+
+// Plays one game, returns the number of guesses it took (MAX_GUESSES + 1 if lost), 0 on a mismatch
+static int play_game(void) {
+    char guess[DICTIONARY_WORD_LENGTH + 1];
+
+    wordDictionaryUnpack(wordDictionaryGetAnswer(xorshift(&seed) % wordDictionaryAnswerCount()), answer);
+
+    start_game();
+    if (wordGuessCoreGetState() != LETTER_EDIT) {
+        fprintf(stderr, "Game did not start\n");
+        return 0;
+    }
+
+    for (int guesses = 1; guesses <= MAX_GUESSES; guesses++) {
+        uint32_t count = wordSolverListCandidates(candidates, sizeof(candidates) / sizeof(candidates[0]));
+        if (count == 0) {
+            fprintf(stderr, "%s: no candidates left after %d guesses\n", answer, guesses - 1);
+            return 0;
+        }
+        wordDictionaryUnpack(wordDictionaryGetAnswer(candidates[xorshift(&seed) % count]), guess);
+        memcpy(typed[guesses - 1], guess, sizeof(guess));
+
+        if (!type_word(guess)) {
+            fprintf(stderr, "%s: could not type %s\n", answer, guess);
+            return 0;
+        }
+        press(WORD_GUESS_EVENT_GUESS);
+
+        bool is_won = strcmp(guess, answer) == 0;
+        bool is_over = is_won || guesses == MAX_GUESSES;
+        wordGuessGameStates_t expected = is_over ? RESULTS : LETTER_EDIT;
+        if (wordGuessCoreGetState() != expected || wordGuessCoreGetGuessCount() != guesses - is_won) {
+            fprintf(stderr, "%s: state %d after guess %d (%s), expected %d\n", answer, wordGuessCoreGetState(),
+                    guesses, guess, expected);
+            return 0;
+        }
+
+        // GUESS on the row just guessed opens the history, once the game is over LEFT does
+        if (is_browsing && !browse_history(guesses, is_over ? WORD_GUESS_EVENT_LEFT : WORD_GUESS_EVENT_GUESS)) {
+            return 0;
+        }
+
+        // Nothing is kept once the game is over
+        if (is_over && checkpoint_size != 0) {
+            fprintf(stderr, "%s: checkpoint left after the game ended\n", answer);
+            return 0;
+        }
+        if (is_browsing && !is_over && !reboot_and_resume(guesses)) {
+            return 0;
+        }
+
+        if (is_over) {
+            if (press(WORD_GUESS_EVENT_EXIT) || wordGuessCoreGetState() != EXITED) {
+                fprintf(stderr, "%s: EXIT did not end the game\n", answer);
+                return 0;
+            }
+            return is_won ? guesses : MAX_GUESSES + 1;
+        }
+    }
+    return 0;
+}
+
+// Plays the games from the same seed, returns false on a mismatch
+static bool run_games(int game_count, bool is_skipping, bool is_browsing_history, uint64_t *outcomes) {
+    uint64_t total_guesses = 0;
+
+    wordGuessCoreSkipAbsentLetters(is_skipping);
+    is_browsing = is_browsing_history;
+    history_rows = 0;
+    resumes = 0;
+    memset(outcomes, 0, (MAX_GUESSES + 2) * sizeof(outcomes[0]));
+    memset(&max7219_stub_counts, 0, sizeof(max7219_stub_counts));
+    led_writes = 0;
+    presses = 0;
+    seed = 0x5EED;
+
+    double start = now_ns();
+    for (int game = 0; game < game_count; game++) {
+        int guesses = play_game();
+        if (guesses == 0) {
+            fprintf(stderr, "Game %d failed\n", game);
+            return false;
+        }
+        outcomes[guesses]++;
+        total_guesses += guesses > MAX_GUESSES ? MAX_GUESSES : guesses;
+    }
+    double elapsed_s = (now_ns() - start) / 1e9;
+
+    if (is_browsing) {
+        printf("History opened after every guess, %llu rows shown, all matched and the board came back\n",
+               (unsigned long long)history_rows);
+        printf("Resumed after %llu reboots, every board came back\n", (unsigned long long)resumes);
+        return true;
+    }
+
+    printf("%s absent letters\n", is_skipping ? "Skipping" : "Showing");
+    printf("%d games in %.2f s, %.0f games/s, all checks passed\n", game_count, elapsed_s, game_count / elapsed_s);
+    printf("won in  ");
+    for (int guesses = 1; guesses <= MAX_GUESSES; guesses++) {
+        printf(" %d: %llu ", guesses, (unsigned long long)outcomes[guesses]);
+    }
+    printf(" lost: %llu\n", (unsigned long long)outcomes[MAX_GUESSES + 1]);
+    printf("per game: %.1f guesses, %.1f presses, %.1f per guess\n", (double)total_guesses / game_count,
+           (double)presses / game_count, (double)presses / total_guesses);
+    printf("per press: %.2f 8x8 images, %.2f frames, %.2f digit writes, %.2f LED writes\n",
+           (double)max7219_stub_counts.images / presses, (double)max7219_stub_counts.frames / presses,
+           (double)max7219_stub_counts.digit_writes / presses, (double)led_writes / presses);
+    return true;
+}
+
+// Holds RIGHT on the carousel from A until Z is under the cursor, like the loop in wordGuessGameStart
+static bool time_alphabet_hold(void) {
+    uint16_t repeats = 0;
+    uint32_t slowest_ms = 0, fastest_ms = UINT32_MAX;
+
+    wordGuessCoreSkipAbsentLetters(false);
+    wordGuessCoreSetSlideTime(0);
+    start_game();
+    press(WORD_GUESS_EVENT_SELECT);
+    for (int step = 0; step < CAROUSEL_LETTERS && getCharAtCursor() != 'A'; step++) {
+        press(WORD_GUESS_EVENT_LEFT);
+    }
+    if (wordGuessCoreGetState() != LETTER_SELECTION || getCharAtCursor() != 'A') {
+        fprintf(stderr, "Could not get the carousel to A\n");
+        return false;
+    }
+
+    memset(&max7219_stub_counts, 0, sizeof(max7219_stub_counts));
+    TickType_t start = xTaskGetTickCount();
+    while (getCharAtCursor() != 'Z' && repeats < CAROUSEL_LETTERS) {
+        uint32_t hold_delay_ms = wordGuessCoreHoldDelay(repeats++);
+        wordGuessCoreSetSlideTime(hold_delay_ms / 2);
+
+        TickType_t step = xTaskGetTickCount();
+        press(WORD_GUESS_EVENT_RIGHT);
+        if (getCharAtCursor() == 'Z') {
+            break;      // Done once the slide onto Z ends
+        }
+        vTaskDelay(step + pdMS_TO_TICKS(hold_delay_ms) - xTaskGetTickCount());
+
+        slowest_ms = hold_delay_ms > slowest_ms ? hold_delay_ms : slowest_ms;
+        fastest_ms = hold_delay_ms < fastest_ms ? hold_delay_ms : fastest_ms;
+    }
+    TickType_t elapsed = xTaskGetTickCount() - start;
+    wordGuessCoreSetSlideTime(wordGuessCoreHoldDelay(0) / 2);
+
+    if (getCharAtCursor() != 'Z') {
+        fprintf(stderr, "Holding RIGHT did not get from A to Z\n");
+        return false;
+    }
+    printf("Holding RIGHT from A to Z: %u ms, %u steps %u to %u ms apart, %.1f frames of %.0f digit writes a step\n",
+           (unsigned)(elapsed * portTICK_PERIOD_MS), repeats, fastest_ms, slowest_ms,
+           (double)max7219_stub_counts.frames / repeats,
+           (double)max7219_stub_counts.digit_writes / max7219_stub_counts.frames);
+
+    // Out of the selection, then out of the game
+    press(WORD_GUESS_EVENT_EXIT);
+    return !press(WORD_GUESS_EVENT_EXIT) && wordGuessCoreGetState() == EXITED;
+}
+
+// A guess missing from the word list is refused on the device, without costing a guess or an api call
+// Then a real guess is played and EXIT must leave nothing to resume
+static bool check_unlisted_guess(void) {
+    uint64_t api_checks_before = api_checks;
+    char guess[DICTIONARY_WORD_LENGTH + 1];
+
+    if (wordDictionaryContains(NOT_A_WORD)) {
+        fprintf(stderr, "The unlisted test word is in the word list\n");
+        return false;
+    }
+
+    wordGuessCoreSkipAbsentLetters(true);
+    wordDictionaryUnpack(wordDictionaryGetAnswer(0), answer);
+    start_game();
+
+    if (!type_word(NOT_A_WORD)) {
+        return false;
+    }
+    press(WORD_GUESS_EVENT_GUESS);
+    if (wordGuessCoreGetState() != LETTER_EDIT || wordGuessCoreGetGuessCount() != 0 || api_checks != api_checks_before) {
+        fprintf(stderr, "%s is not in the word list but was played\n", NOT_A_WORD);
+        return false;
+    }
+    printf("Unlisted guess: %s refused\n", NOT_A_WORD);
+
+    // One guess played, then EXIT leaves the game for good
+    wordDictionaryUnpack(wordDictionaryGet(0), guess);
+    if (strcmp(guess, answer) == 0 || !type_word(guess)) {
+        return false;
+    }
+    press(WORD_GUESS_EVENT_GUESS);
+    if (checkpoint_size == 0 || press(WORD_GUESS_EVENT_EXIT) || wordGuessCoreGetState() != EXITED || checkpoint_size != 0) {
+        fprintf(stderr, "EXIT after %s did not clear the checkpoint\n", guess);
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char **argv) {
+    int game_count = argc > 1 ? atoi(argv[1]) : DEFAULT_GAME_COUNT;
+    const char *path = argc > 2 ? argv[2] : DICTIONARY_IMAGE_PATH;
+
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) {
+        perror(path);
+        return 1;
+    }
+    size_t size = fread(image, 1, sizeof(image), file);
+    fclose(file);
+
+    if (game_count <= 0 || !wordDictionaryAttach(image, size) || !wordSolverInit()) {
+        fprintf(stderr, "%s: not a valid dictionary image with answers\n", path);
+        return 1;
+    }
+
+    display_init();
+    if (wordGuessCoreInit(&sim_backend) != ESP_OK) {
+        return 1;
+    }
+
+    uint64_t outcomes[MAX_GUESSES + 2], resumed_outcomes[MAX_GUESSES + 2];
+    if (!run_games(game_count, false, false, outcomes) || !run_games(game_count, true, false, outcomes) ||
+        !run_games(game_count, true, true, resumed_outcomes) || !time_alphabet_hold()) {
+        return 1;
+    }
+    if (memcmp(outcomes, resumed_outcomes, sizeof(outcomes)) != 0) {
+        printf("Games played with reboots ended differently\n");
+        return 1;
+    }
+    if (api_checks != 0) {
+        printf("api checks: %llu (expected none)\n", (unsigned long long)api_checks);
+        return 1;
+    }
+    return check_unlisted_guess() ? 0 : 1;
+}
@@ -0,0 +1,4 @@
+// Tick count behind the FreeRTOS shim (shims/freertos/task.h)
+#include "freertos/task.h"
+
+TickType_t hostTickCount = 0;
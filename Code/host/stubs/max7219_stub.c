@@ -0,0 +1,87 @@
+/*
+ Stand-in for the max7219 driver on the host. Draws go nowhere, the calls
+ are only counted, so the simulator can report how much SPI traffic a game
+ would cause. matrixDisplay keeps its own copy of what is on the screens.
+*/
+#include <string.h>
+#include "max7219.h"
+#include "max7219_stub.h"
+
+max7219_stub_counts_t max7219_stub_counts;
+
+esp_err_t max7219_init_desc(max7219_t *dev, spi_host_device_t host, uint32_t clock_speed_hz, gpio_num_t cs_pin) {
+    (void)host;
+    (void)clock_speed_hz;
+    (void)cs_pin;
+    memset(&dev->spi_cfg, 0, sizeof(dev->spi_cfg));
+    dev->spi_dev = NULL;
+    return ESP_OK;
+}
+
+esp_err_t max7219_free_desc(max7219_t *dev) {
+    (void)dev;
+    return ESP_OK;
+}
+
+esp_err_t max7219_init(max7219_t *dev) {
+    (void)dev;
+    return ESP_OK;
+}
+
+esp_err_t max7219_set_decode_mode(max7219_t *dev, bool bcd) {
+    dev->bcd = bcd;
+    return ESP_OK;
+}
+
+esp_err_t max7219_set_brightness(max7219_t *dev, uint8_t value) {
+    (void)dev;
+    if (value > MAX7219_MAX_BRIGHTNESS) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    max7219_stub_counts.brightness++;
+    return ESP_OK;
+}
+
+esp_err_t max7219_set_shutdown_mode(max7219_t *dev, bool shutdown) {
+    (void)dev;
+    (void)shutdown;
+    return ESP_OK;
+}
+
+esp_err_t max7219_set_digit(max7219_t *dev, uint8_t digit, uint8_t val) {
+    (void)dev;
+    (void)digit;
+    (void)val;
+    max7219_stub_counts.digit_writes++;
+    return ESP_OK;
+}
+
+esp_err_t max7219_clear(max7219_t *dev) {
+    (void)dev;
+    max7219_stub_counts.clears++;
+    return ESP_OK;
+}
+
+esp_err_t max7219_draw_text_7seg(max7219_t *dev, uint8_t pos, const char *s) {
+    (void)dev;
+    (void)pos;
+    (void)s;
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t max7219_draw_image_8x8(max7219_t *dev, uint8_t pos, const void *image) {
+    (void)dev;
+    (void)pos;
+    (void)image;
+    max7219_stub_counts.images++;
+    max7219_stub_counts.digit_writes += 8;
+    return ESP_OK;
+}
+
+esp_err_t max7219_draw_images_8x8(max7219_t *dev, const void *images) {
+    (void)dev;
+    (void)images;
+    max7219_stub_counts.frames++;
+    max7219_stub_counts.digit_writes += 8;  // One per row, each carries every matrix
+    return ESP_OK;
+}
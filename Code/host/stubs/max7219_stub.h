@@ -0,0 +1,14 @@
+// Counters kept by the max7219 stub, each is one transfer the real driver would send over SPI
+#pragma once
+
+#include <stdint.h>
+
+typedef struct {
+    uint64_t digit_writes;      // 8x8 images are 8 digit writes each
+    uint64_t images;
+    uint64_t frames;            // Whole cascades drawn at once, 8 digit writes each
+    uint64_t clears;
+    uint64_t brightness;
+} max7219_stub_counts_t;
+
+extern max7219_stub_counts_t max7219_stub_counts;
@@ -0,0 +1,143 @@
+/*
+ Generates the opening book the hint feature uses for the first two guesses
+ (wordGuessGame/openingBook.c). Finds the best first guess over the whole
+ answer list, or takes the one given, then for each of the 243 results it can
+ give works out the best second guess for the answers left. Scoring and ties
+ are the same as wordHintSuggest, so the book gives what the device would.
+
+ Rerun it whenever the word lists change; the device ignores a book made for
+ a different dictionary and falls back to searching.
+
+ Usage: gen_opening_book [dictionary.bin] [openingBook.c] [opener]
+*/
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "wordDictionary.h"
+#include "guessEvaluator.h"
+#include "wordSolver.h"
+
+// With this few answers left, wordHintSuggest picks the first one without searching
+#define DIRECT_PICK_MAX 2
+
+static uint32_t image[64 * 1024];   // Big enough for the dict partition
+static uint32_t answers[8192];
+
+// Best guess for the candidates left in the solver, DICTIONARY_INVALID_WORD if none are left
+static uint32_t best_guess(uint32_t *answer_count, float *best_score) {
+    uint32_t best = DICTIONARY_INVALID_WORD;
+
+    *answer_count = wordSolverListCandidates(answers, sizeof(answers) / sizeof(answers[0]));
+    *best_score = 0;
+    for (uint32_t i = 0; i < *answer_count; i++) {
+        answers[i] = wordDictionaryGetAnswer(answers[i]);
+    }
+
+    if (*answer_count == 0) {
+        return DICTIONARY_INVALID_WORD;
+    }
+    if (*answer_count <= DIRECT_PICK_MAX) {
+        return answers[0];
+    }
+
+    *best_score = -1;
+    for (uint32_t guess = 0; guess < wordDictionarySize(); guess++) {
+        float score = wordSolverScoreGuess(wordDictionaryGet(guess), answers, *answer_count);
+        if (score > *best_score) {
+            *best_score = score;
+            best = wordDictionaryGet(guess);
+        }
+    }
+    return best;
+}
+
+// Result string for a pattern number, first letter is the lowest digit
+static void pattern_result(uint16_t pattern, char *result) {
+    static const char digits[3] = {RESULT_WRONG, RESULT_SWAP, RESULT_CORRECT};
+    for (int pos = 0; pos < GUESS_LETTER_COUNT; pos++) {
+        result[pos] = digits[pattern % 3];
+        pattern /= 3;
+    }
+    result[GUESS_LETTER_COUNT] = '\0';
+}
+
+int main(int argc, char **argv) {
+    const char *path = argc > 1 ? argv[1] : DICTIONARY_IMAGE_PATH;
+    const char *out_path = argc > 2 ? argv[2] : OPENING_BOOK_PATH;
+    char opener[DICTIONARY_WORD_LENGTH + 1];
+    uint32_t replies[WORD_SOLVER_PATTERN_COUNT];
+    uint32_t answer_count, opener_packed, reply_count = 0;
+    float score;
+
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) {
+        perror(path);
+        return 1;
+    }
+    size_t size = fread(image, 1, sizeof(image), file);
+    fclose(file);
+
+    if (!wordDictionaryAttach(image, size) || !wordSolverInit()) {
+        fprintf(stderr, "%s: not a valid dictionary image with answers\n", path);
+        return 1;
+    }
+
+    clock_t start = clock();
+
+    if (argc > 3) {
+        if (strlen(argv[3]) != DICTIONARY_WORD_LENGTH || !wordDictionaryContains(argv[3])) {
+            fprintf(stderr, "%s: not in the word list\n", argv[3]);
+            return 1;
+        }
+        opener_packed = wordDictionaryPack(argv[3]);
+    } else {
+        wordSolverReset();
+        opener_packed = best_guess(&answer_count, &score);
+        printf("opener %.3f bits\n", score);
+    }
+    wordDictionaryUnpack(opener_packed, opener);
+
+    for (uint16_t pattern = 0; pattern < WORD_SOLVER_PATTERN_COUNT; pattern++) {
+        char result[GUESS_LETTER_COUNT + 1];
+        pattern_result(pattern, result);
+        wordSolverReset();
+        wordSolverApply(opener, result);
+        replies[pattern] = best_guess(&answer_count, &score);
+        reply_count += replies[pattern] != DICTIONARY_INVALID_WORD;
+    }
+
+    FILE *out = fopen(out_path, "w");
+    if (out == NULL) {
+        perror(out_path);
+        return 1;
+    }
+
+    fprintf(out, "// Generated by Code/host/tools/gen_opening_book.c, do not edit\n");
+    fprintf(out, "// Best second guess after \"%s\" for each of its results\n\n", opener);
+    fprintf(out, "#include \"wordDictionary.h\"\n#include \"openingBook.h\"\n\n");
+    fprintf(out, "const openingBook_t openingBook =\n{\n");
+    fprintf(out, "    .wordCount = %u,\n", wordDictionarySize());
+    fprintf(out, "    .answerCount = %u,\n", wordDictionaryAnswerCount());
+    fprintf(out, "    .opener = 0x%07X, // %s\n", opener_packed, opener);
+    fprintf(out, "    .replies =\n    {\n");
+    for (uint16_t pattern = 0; pattern < WORD_SOLVER_PATTERN_COUNT; pattern++) {
+        char result[GUESS_LETTER_COUNT + 1];
+        char reply[DICTIONARY_WORD_LENGTH + 1];
+        pattern_result(pattern, result);
+        if (replies[pattern] == DICTIONARY_INVALID_WORD) {
+            fprintf(out, "        DICTIONARY_INVALID_WORD, // %s\n", result);
+        } else {
+            wordDictionaryUnpack(replies[pattern], reply);
+            fprintf(out, "        0x%07X, // %s %s\n", replies[pattern], result, reply);
+        }
+    }
+    fprintf(out, "    }\n};\n");
+    fclose(out);
+
+    printf("opener %s, %u of %d results possible, %.1f s\n", opener, reply_count, WORD_SOLVER_PATTERN_COUNT,
+           (double)(clock() - start) / CLOCKS_PER_SEC);
+    printf("wrote %s\n", out_path);
+    return 0;
+}
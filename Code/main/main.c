@@ -1,9 +1,19 @@
 #include "esp_log.h"
 #include <gpioControl.h>
 #include <wifi.h>
+#include <time_sync.h>
 #include "api_client.h"
+#include "api_request.h"
+#ifdef CONFIG_API_BENCH
+#include "api_bench.h"
+#endif
 #include <matrixDisplay.h>
 #include <wordGuessGame.h>
+#include <dailyWord.h>
+#include <dictionaryPartition.h>
+#ifdef CONFIG_WORD_DICTIONARY_BENCH
+#include <dictionaryBench.h>
+#endif
 
 #define LOG_TAG  "main"
 
@@ -12,7 +22,18 @@ int app_main(void)
     initGPIO();
     ESP_LOGI(LOG_TAG, "ESP32 WiFi Station");
     wifi_init_sta();
+    time_sync_start(CONFIG_API_UTC_OFFSET_HOURS);
     api_client_init();
+#ifdef CONFIG_API_BENCH
+    api_bench_run(CONFIG_API_BENCH_REQUESTS);
+#endif
+    api_request_init();
+    wordGuessGamePrefetch();    // Runs while the splash is showing
+    dailyWordStartRollover();
+    initWordDictionary();
+#ifdef CONFIG_WORD_DICTIONARY_BENCH
+    wordDictionaryBench();
+#endif
     display_init();  
     ESP_LOGI(LOG_TAG, "Boot successful");
     
@@ -0,0 +1,165 @@
+#!/usr/bin/env python3
+"""
+Packs a word list into the dictionary image flashed to the "dict" partition.
+
+Each five letter word is packed into 25 bits, five letters of 5 bits each with the
+first letter in the highest bits ('a' = 0 ... 'z' = 25). Numeric order of the packed
+words is then the same as alphabetical order, so the table can be binary searched.
+The image layout is described in wordDictionary/include/dictionaryFormat.h.
+
+The answer list (words that can be picked as the daily word when offline) goes in
+its own section, every answer is also accepted as a guess.
+
+Run by the wordDictionary build, or by hand to update the list without reflashing
+the app:
+    python3 gen_dictionary.py --words ../Components/wordDictionary/words/guesses.txt \
+        --answers ../Components/wordDictionary/words/answers.txt --image-out dictionary.bin
+    parttool.py write_partition --partition-name dict --input dictionary.bin
+"""
+
+import argparse
+import struct
+import sys
+import zlib
+
+WORD_LENGTH = 5
+BITS_PER_LETTER = 5
+
+# Must match dictionaryHeader_t
+DICTIONARY_MAGIC = 0x43494457   # "WDIC"
+DICTIONARY_FORMAT_VERSION = 3
+HEADER_FORMAT = "<IHHIIIIIIIIIII"
+HEADER_SIZE = struct.calcsize(HEADER_FORMAT)
+INDEX_BUCKETS = 26 * 26
+BLOOM_BLOCK_SIZE = 64
+BLOOM_BLOCK_BITS = BLOOM_BLOCK_SIZE * 8
+MASK64 = (1 << 64) - 1
+
+
+def pack(word):
+    packed = 0
+    for letter in word:
+        packed = (packed << BITS_PER_LETTER) | (ord(letter) - ord("a"))
+    return packed
+
+
+def load_words(path):
+    """Reads one word per line, '#' starts a comment. Returns the packed words sorted."""
+    packed = set()
+    with open(path, encoding="utf-8") as words_file:
+        for line_number, line in enumerate(words_file, 1):
+            word = line.split("#", 1)[0].strip().lower()
+            if not word:
+                continue
+            if len(word) != WORD_LENGTH or not word.isascii() or not word.isalpha():
+                sys.exit(f"{path}:{line_number}: '{word}' is not a {WORD_LENGTH} letter word")
+            packed.add(pack(word))
+    return sorted(packed)
+
+
+def build_index(words):
+    """Start of each first-two-letter bucket, plus wordCount as the end of the last one."""
+    if len(words) > 0xFFFF:
+        sys.exit(f"{len(words)} words do not fit the 16 bit index")
+
+    index = []
+    position = 0
+    for bucket in range(INDEX_BUCKETS):
+        prefix = (bucket // 26) << BITS_PER_LETTER | (bucket % 26)
+        while position < len(words) and words[position] >> (3 * BITS_PER_LETTER) < prefix:
+            position += 1
+        index.append(position)
+    index.append(len(words))
+    return struct.pack(f"<{len(index)}H", *index)
+
+
+def bloom_hash(packed):
+    """MurmurHash3 fmix64, must match dictionaryBloomHash."""
+    h = packed
+    h ^= h >> 33
+    h = (h * 0xFF51AFD7ED558CCD) & MASK64
+    h ^= h >> 33
+    h = (h * 0xC4CEB9FE1A85EC53) & MASK64
+    h ^= h >> 33
+    return h
+
+
+def build_bloom(words, size, probes):
+    """Blocked bloom filter, every word sets its probes inside one 64 byte block."""
+    block_count = size // BLOOM_BLOCK_SIZE
+    bits = bytearray(size)
+    for word in words:
+        h = bloom_hash(word)
+        low = h & 0xFFFFFFFF
+        block = ((h >> 32) * block_count) >> 32
+        first = low % BLOOM_BLOCK_BITS
+        step = ((low // BLOOM_BLOCK_BITS) % BLOOM_BLOCK_BITS) | 1
+        for probe in range(probes):
+            bit = (first + probe * step) % BLOOM_BLOCK_BITS
+            # Little endian uint32_t words, bit n of word n / 32
+            byte = block * BLOOM_BLOCK_SIZE + (bit // 32) * 4 + (bit % 32) // 8
+            bits[byte] |= 1 << (bit % 8)
+    return bytes(bits)
+
+
+def build_image(words, answers, with_index=True, bloom_size=0, bloom_probes=0):
+    """Header, packed words, answers, and unless disabled the first-two-letter index and the bloom filter."""
+    words_offset = HEADER_SIZE
+    words_blob = struct.pack(f"<{len(words)}I", *words)
+    index_blob = build_index(words) if with_index else b""
+    bloom_blob = build_bloom(words, bloom_size, bloom_probes) if bloom_size else b""
+
+    body = words_blob
+    answers_offset = words_offset + len(body) if answers else 0
+    body += struct.pack(f"<{len(answers)}I", *answers)
+    index_offset = words_offset + len(body) if index_blob else 0
+    body += index_blob
+
+    bloom_offset = 0
+    if bloom_blob:
+        # Start the filter on a cache line so each block is exactly one line
+        body += b"\0" * (-(words_offset + len(body)) % BLOOM_BLOCK_SIZE)
+        bloom_offset = words_offset + len(body)
+        body += bloom_blob
+
+    image_size = words_offset + len(body)
+
+    fields = [DICTIONARY_MAGIC, DICTIONARY_FORMAT_VERSION, HEADER_SIZE, image_size,
+              len(words), words_offset, index_offset, len(index_blob),
+              bloom_offset, len(bloom_blob), bloom_probes if bloom_blob else 0,
+              answers_offset, len(answers)]
+    header_crc = zlib.crc32(struct.pack(HEADER_FORMAT[:-1], *fields))
+    header = struct.pack(HEADER_FORMAT, *fields, header_crc)
+
+    return header + body
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument("--words", required=True, help="Word list, one word per line")
+    parser.add_argument("--answers", help="Answer list for the offline daily word, one word per line")
+    parser.add_argument("--image-out", required=True, help="Dictionary image to write")
+    parser.add_argument("--no-index", action="store_true", help="Leave out the first-two-letter index")
+    parser.add_argument("--bloom-size", type=int, default=16384,
+                        help=f"Bloom filter bytes, a multiple of {BLOOM_BLOCK_SIZE}, 0 to leave it out")
+    parser.add_argument("--bloom-probes", type=int, default=7, help="Bits set per word in the bloom filter")
+    parser.add_argument("--max-size", type=lambda size: int(size, 0), help="Size of the dict partition")
+    args = parser.parse_args()
+
+    if args.bloom_size % BLOOM_BLOCK_SIZE or not 1 <= args.bloom_probes <= 16:
+        sys.exit(f"--bloom-size must be a multiple of {BLOOM_BLOCK_SIZE} and --bloom-probes 1 to 16")
+
+    answers = load_words(args.answers) if args.answers else []
+    words = sorted(set(load_words(args.words)) | set(answers))
+    image = build_image(words, answers, with_index=not args.no_index, bloom_size=args.bloom_size,
+                        bloom_probes=args.bloom_probes)
+    if args.max_size is not None and len(image) > args.max_size:
+        sys.exit(f"Dictionary image is {len(image)} bytes, the dict partition only holds {args.max_size}")
+
+    with open(args.image_out, "wb") as out:
+        out.write(image)
+    print(f"Packed {len(words)} words and {len(answers)} answers into a {len(image)} byte dictionary image")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,165 @@
+#!/usr/bin/env python3
+"""
+Local stand-in for the Wordle game API used by apiControl.
+
+Serves POST /word and POST /guess with the same JSON shapes as the real
+service, and can inject latency, jitter, server errors, truncated bodies and
+rate limiting so the client's failure handling can be exercised without
+internet access or the daily request quota.
+
+Point the firmware at it through menuconfig:
+    CONFIG_API_GET_WORD_URL  = "http://<host ip>:8080/word"
+    CONFIG_API_CHECK_WORD_URL = "http://<host ip>:8080/guess"
+
+Example:
+    python3 mock_api_server.py --latency-ms 150 --jitter-ms 100 --error-rate 0.05 \
+        --truncate-rate 0.05 --rate-limit 30
+"""
+
+import argparse
+import datetime
+import json
+import random
+import threading
+import time
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+
+WORDS = [
+    "crane", "slate", "trace", "pious", "ghost", "lemon", "brick", "flame",
+    "quilt", "sword", "vivid", "happy", "eerie", "robot", "plumb", "chant",
+]
+
+
+def word_for_timezone(timezone):
+    """Picks the word of the day for a "UTC + N" timezone string."""
+    try:
+        offset = int(timezone.replace("UTC", "").replace(" ", "") or 0)
+    except ValueError:
+        offset = 0
+    today = (datetime.datetime.now(datetime.timezone.utc) + datetime.timedelta(hours=offset)).date()
+    return WORDS[today.toordinal() % len(WORDS)], today
+
+
+def evaluate(guess, target):
+    """Same result pattern as the service: '+' right place, 'x' wrong place, '-' absent."""
+    result = ["-"] * len(guess)
+    remaining = {}
+    for g, t in zip(guess, target):
+        if g != t:
+            remaining[t] = remaining.get(t, 0) + 1
+    for i, (g, t) in enumerate(zip(guess, target)):
+        if g == t:
+            result[i] = "+"
+        elif remaining.get(g, 0) > 0:
+            result[i] = "x"
+            remaining[g] -= 1
+    return "".join(result)
+
+
+class RateLimiter:
+    """Fixed one minute window, like the API gateway in front of the real service."""
+
+    def __init__(self, per_minute):
+        self.per_minute = per_minute
+        self.window_start = time.monotonic()
+        self.count = 0
+        self.lock = threading.Lock()
+
+    def allow(self):
+        if self.per_minute <= 0:
+            return True
+        with self.lock:
+            now = time.monotonic()
+            if now - self.window_start >= 60:
+                self.window_start = now
+                self.count = 0
+            self.count += 1
+            return self.count <= self.per_minute
+
+
+class MockApiHandler(BaseHTTPRequestHandler):
+    protocol_version = "HTTP/1.1"   # Keep-alive, the client reuses its connection
+
+    def do_POST(self):
+        args = self.server.args
+        length = int(self.headers.get("Content-Length", 0))
+        try:
+            request = json.loads(self.rfile.read(length) or b"{}")
+        except json.JSONDecodeError:
+            request = {}
+
+        delay = max(0.0, args.latency_ms + random.uniform(-args.jitter_ms, args.jitter_ms)) / 1000
+        time.sleep(delay)
+
+        if not self.server.limiter.allow():
+            self.send_json(429, {"message": "You have exceeded the rate limit per minute for your plan"})
+            return
+        if random.random() < args.error_rate:
+            self.send_json(500, {"message": "Internal server error"})
+            return
+
+        timezone = request.get("timezone", "UTC + 0")
+        target, today = word_for_timezone(timezone)
+
+        if self.path == "/word":
+            body = {"word": target, "timezone": timezone, "date": today.isoformat()}
+        elif self.path == "/guess":
+            guess = str(request.get("word", "")).lower()
+            if len(guess) != len(target):
+                self.send_json(400, {"message": "Guess must be 5 letters"})
+                return
+            body = {"guess": guess, "result": evaluate(guess, target), "isWordInList": True}
+        else:
+            self.send_json(404, {"message": "Not found"})
+            return
+
+        self.send_json(200, body, truncate=random.random() < args.truncate_rate)
+
+    def send_json(self, status, body, truncate=False):
+        payload = json.dumps(body).encode()
+        self.send_response(status)     # Also sends the Date header the client sets its clock from
+        self.send_header("Content-Type", "application/json")
+        self.send_header("Content-Length", str(len(payload)))
+        if truncate:
+            # Promise the full body, send half of it and hang up
+            self.send_header("Connection", "close")
+            self.end_headers()
+            self.wfile.write(payload[:len(payload) // 2])
+            self.close_connection = True
+        else:
+            self.end_headers()
+            self.wfile.write(payload)
+
+    def log_message(self, fmt, *log_args):
+        if not self.server.args.quiet:
+            super().log_message(fmt, *log_args)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Mock Wordle game API for testing apiControl offline")
+    parser.add_argument("--host", default="0.0.0.0")
+    parser.add_argument("--port", type=int, default=8080)
+    parser.add_argument("--latency-ms", type=float, default=0, help="Base delay before every response")
+    parser.add_argument("--jitter-ms", type=float, default=0, help="Uniform +/- jitter on the delay")
+    parser.add_argument("--error-rate", type=float, default=0, help="Fraction of requests answered with 500")
+    parser.add_argument("--truncate-rate", type=float, default=0, help="Fraction of bodies cut off halfway")
+    parser.add_argument("--rate-limit", type=int, default=0, help="Requests per minute before 429, 0 for none")
+    parser.add_argument("--seed", type=int, help="Seed for repeatable fault injection")
+    parser.add_argument("--quiet", action="store_true", help="Don't log every request")
+    args = parser.parse_args()
+
+    if args.seed is not None:
+        random.seed(args.seed)
+
+    server = ThreadingHTTPServer((args.host, args.port), MockApiHandler)
+    server.args = args
+    server.limiter = RateLimiter(args.rate_limit)
+    print(f"Mock API listening on http://{args.host}:{args.port} (/word, /guess)")
+    try:
+        server.serve_forever()
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()